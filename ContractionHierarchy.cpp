@@ -0,0 +1,293 @@
+#include "ContractionHierarchy.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace {
+const double kInfinity = std::numeric_limits<double>::infinity();
+const int kWitnessSettleLimit = 500;    // 见证搜索最多确定的节点数
+}
+
+ContractionHierarchy::ContractionHierarchy(std::shared_ptr<const CsrGraph> graph)
+    : graph(std::move(graph)), shortcuts(0) {
+    CAMPUS_PROFILE_SCOPE("ch.build");
+    contract();
+
+    int n = this->graph->size();
+    for (int d = 0; d < 2; ++d) {
+        dist[d].assign(n, kInfinity);
+        prev[d].assign(n, -1);
+        heaps[d].reset(n);
+    }
+}
+
+bool ContractionHierarchy::isBuiltFor(const CsrGraph* snapshot) const {
+    return graph.get() == snapshot;
+}
+
+int ContractionHierarchy::shortcutCount() const {
+    return shortcuts;
+}
+
+void ContractionHierarchy::contract() {
+    int n = graph->size();
+
+    // 从快照复制出可修改的邻接表，合并平行边并忽略自环
+    std::vector<std::vector<Arc>> adj(n);
+    for (int v = 0; v < n; ++v) {
+        for (int e = graph->offsets[v]; e < graph->offsets[v + 1]; ++e) {
+            int to = graph->neighbors[e];
+            if (to != v) {
+                addOrRelax(adj[v], to, graph->weights[e], -1);
+            }
+        }
+    }
+
+    contracted.assign(n, 0);
+    witnessDist.assign(n, kInfinity);
+    witnessHeap.reset(n);
+    rank.assign(n, -1);
+    std::vector<int> deletedNeighbors(n, 0);
+
+    // 优先级 = 边差（新增捷径数 - 剩余度数）+ 已收缩邻居数
+    auto priority = [&](int v) {
+        int liveDegree = 0;
+        for (const Arc& arc : adj[v]) {
+            if (!contracted[arc.to]) ++liveDegree;
+        }
+        return static_cast<double>(simulateContraction(v, adj, false) - liveDegree + deletedNeighbors[v]);
+    };
+
+    IndexedHeap order(n);
+    for (int v = 0; v < n; ++v) {
+        order.push(v, priority(v));
+    }
+
+    // 惰性更新：弹出时重新计算优先级，若已不是最小则放回
+    int nextRank = 0;
+    while (!order.empty()) {
+        int v = order.pop();
+        double current = priority(v);
+        if (!order.empty() && current > order.topKey()) {
+            order.push(v, current);
+            continue;
+        }
+
+        shortcuts += simulateContraction(v, adj, true);
+        contracted[v] = 1;
+        rank[v] = nextRank++;
+        for (const Arc& arc : adj[v]) {
+            if (!contracted[arc.to]) ++deletedNeighbors[arc.to];
+        }
+    }
+
+    // 只保留指向更高层节点的弧，组成紧凑的向上图
+    upOffsets.assign(n + 1, 0);
+    for (int v = 0; v < n; ++v) {
+        for (const Arc& arc : adj[v]) {
+            if (rank[arc.to] > rank[v]) ++upOffsets[v + 1];
+        }
+    }
+    for (int v = 0; v < n; ++v) {
+        upOffsets[v + 1] += upOffsets[v];
+    }
+    upArcs.resize(upOffsets[n]);
+    for (int v = 0; v < n; ++v) {
+        int cursor = upOffsets[v];
+        for (const Arc& arc : adj[v]) {
+            if (rank[arc.to] > rank[v]) upArcs[cursor++] = arc;
+        }
+    }
+
+    // 释放预处理工作区
+    witnessDist = std::vector<double>();
+    witnessTouched = std::vector<int>();
+    contracted = std::vector<char>();
+    witnessHeap.reset(0);
+}
+
+int ContractionHierarchy::simulateContraction(int v, std::vector<std::vector<Arc>>& adj, bool apply) {
+    std::vector<Arc> live;
+    for (const Arc& arc : adj[v]) {
+        if (!contracted[arc.to]) live.push_back(arc);
+    }
+
+    int added = 0;
+    for (size_t i = 0; i < live.size(); ++i) {
+        double maxOut = 0.0;
+        for (size_t j = i + 1; j < live.size(); ++j) {
+            maxOut = std::max(maxOut, live[j].weight);
+        }
+        if (i + 1 == live.size()) break;
+
+        int u = live[i].to;
+        witnessSearch(adj, u, v, live[i].weight + maxOut);
+        for (size_t j = i + 1; j < live.size(); ++j) {
+            int w = live[j].to;
+            double via = live[i].weight + live[j].weight;
+            if (witnessDist[w] > via) {
+                ++added;
+                if (apply) {
+                    addOrRelax(adj[u], w, via, v);
+                    addOrRelax(adj[w], u, via, v);
+                }
+            }
+        }
+
+        for (int index : witnessTouched) {
+            witnessDist[index] = kInfinity;
+        }
+        witnessTouched.clear();
+    }
+    return added;
+}
+
+void ContractionHierarchy::witnessSearch(const std::vector<std::vector<Arc>>& adj, int from,
+                                         int excluded, double limit) {
+    witnessHeap.clear();
+    witnessDist[from] = 0.0;
+    witnessTouched.push_back(from);
+    witnessHeap.push(from, 0.0);
+
+    int settledCount = 0;
+    while (!witnessHeap.empty() && settledCount < kWitnessSettleLimit) {
+        if (witnessHeap.topKey() > limit) break;
+        int current = witnessHeap.pop();
+        ++settledCount;
+
+        for (const Arc& arc : adj[current]) {
+            if (arc.to == excluded || contracted[arc.to]) continue;
+            double newDist = witnessDist[current] + arc.weight;
+            if (newDist < witnessDist[arc.to]) {
+                if (witnessDist[arc.to] == kInfinity) witnessTouched.push_back(arc.to);
+                witnessDist[arc.to] = newDist;
+                witnessHeap.push(arc.to, newDist);
+            }
+        }
+    }
+    witnessHeap.clear();
+}
+
+void ContractionHierarchy::addOrRelax(std::vector<Arc>& arcs, int to, double weight, int middle) {
+    for (Arc& arc : arcs) {
+        if (arc.to == to) {
+            if (weight < arc.weight) {
+                arc.weight = weight;
+                arc.middle = middle;
+            }
+            return;
+        }
+    }
+    arcs.push_back({to, weight, middle});
+}
+
+const ContractionHierarchy::Arc* ContractionHierarchy::findUpArc(int lower, int upper) const {
+    for (int e = upOffsets[lower]; e < upOffsets[lower + 1]; ++e) {
+        if (upArcs[e].to == upper) return &upArcs[e];
+    }
+    return nullptr;
+}
+
+void ContractionHierarchy::unpack(int from, int to, std::vector<int>& out) const {
+    // 用显式栈展开，避免捷径嵌套过深时递归溢出
+    std::vector<std::pair<int, int>> stack;
+    stack.push_back({from, to});
+    while (!stack.empty()) {
+        auto [a, b] = stack.back();
+        stack.pop_back();
+
+        const Arc* arc = rank[a] < rank[b] ? findUpArc(a, b) : findUpArc(b, a);
+        if (!arc || arc->middle == -1) {
+            out.push_back(b);
+        } else {
+            stack.push_back({arc->middle, b});
+            stack.push_back({a, arc->middle});
+        }
+    }
+}
+
+RouteResult ContractionHierarchy::shortestPath(int src, int dst) {
+    CAMPUS_PROFILE_SCOPE("ch.query");
+    RouteResult result;
+    int source = graph->indexOf(src);
+    int target = graph->indexOf(dst);
+    if (source == -1 || target == -1) {
+        return result;
+    }
+
+    for (int d = 0; d < 2; ++d) {
+        for (int index : touched[d]) {
+            dist[d][index] = kInfinity;
+            prev[d][index] = -1;
+        }
+        touched[d].clear();
+        heaps[d].clear();
+    }
+
+    dist[0][source] = 0.0;
+    dist[1][target] = 0.0;
+    touched[0].push_back(source);
+    touched[1].push_back(target);
+    heaps[0].push(source, 0.0);
+    heaps[1].push(target, 0.0);
+
+    double best = kInfinity;
+    int meet = -1;
+    while (true) {
+        // 某一方向的最小键值不小于当前最优值时，该方向可以停止
+        for (int d = 0; d < 2; ++d) {
+            if (!heaps[d].empty() && heaps[d].topKey() >= best) heaps[d].clear();
+        }
+        if (heaps[0].empty() && heaps[1].empty()) break;
+
+        int d = heaps[1].empty() || (!heaps[0].empty() && heaps[0].topKey() <= heaps[1].topKey()) ? 0 : 1;
+        int current = heaps[d].pop();
+        ++result.settledCount;
+
+        double candidate = dist[d][current] + dist[1 - d][current];
+        if (candidate < best) {
+            best = candidate;
+            meet = current;
+        }
+
+        for (int e = upOffsets[current]; e < upOffsets[current + 1]; ++e) {
+            const Arc& arc = upArcs[e];
+            double newDist = dist[d][current] + arc.weight;
+            if (newDist < dist[d][arc.to]) {
+                if (dist[d][arc.to] == kInfinity) touched[d].push_back(arc.to);
+                dist[d][arc.to] = newDist;
+                prev[d][arc.to] = current;
+                heaps[d].push(arc.to, newDist);
+            }
+        }
+    }
+
+    if (meet == -1) {
+        return result;
+    }
+
+    // 拼接向上图中的节点序列：起点 -> 相遇点 -> 终点
+    std::vector<int> hierarchyPath;
+    for (int at = meet; at != -1; at = prev[0][at]) {
+        hierarchyPath.push_back(at);
+    }
+    std::reverse(hierarchyPath.begin(), hierarchyPath.end());
+    for (int at = prev[1][meet]; at != -1; at = prev[1][at]) {
+        hierarchyPath.push_back(at);
+    }
+
+    // 展开捷径
+    std::vector<int> densePath;
+    densePath.push_back(hierarchyPath.front());
+    for (size_t i = 0; i + 1 < hierarchyPath.size(); ++i) {
+        unpack(hierarchyPath[i], hierarchyPath[i + 1], densePath);
+    }
+
+    result.found = true;
+    result.distance = best;
+    for (int index : densePath) {
+        result.path.push_back(graph->vexNum(index));
+    }
+    return result;
+}
@@ -0,0 +1,55 @@
+#ifndef CONTRACTIONHIERARCHY_H
+#define CONTRACTIONHIERARCHY_H
+
+#include "Graph.h"
+#include "IndexedHeap.h"
+#include "RoutingEngine.h"
+#include <memory>
+#include <vector>
+
+// 收缩层次（Contraction Hierarchies）索引
+// 预处理时按重要度依次收缩节点并添加捷径，查询时只做双向向上搜索，
+// 最后把捷径展开为原图中的节点序列。索引绑定到构建时的CSR快照。
+class ContractionHierarchy {
+public:
+    explicit ContractionHierarchy(std::shared_ptr<const CsrGraph> graph); // 构造并完成预处理
+
+    RouteResult shortestPath(int src, int dst);  // 点对点最短路径（参数为节点编号）
+    bool isBuiltFor(const CsrGraph* snapshot) const; // 索引是否对应该快照
+    int shortcutCount() const;                   // 预处理添加的捷径数
+
+private:
+    struct Arc {
+        int to;                                  // 目标稠密下标
+        double weight;                           // 权重
+        int middle;                              // 捷径经过的中间节点，原始边为 -1
+    };
+
+    void contract();                             // 预处理：计算收缩顺序并生成向上图
+    int simulateContraction(int v, std::vector<std::vector<Arc>>& adj, bool apply); // 返回需要的捷径数
+    void witnessSearch(const std::vector<std::vector<Arc>>& adj, int from,
+                       int excluded, double limit); // 不经过 excluded 的有限局部搜索，结果写入 witnessDist
+    void addOrRelax(std::vector<Arc>& arcs, int to, double weight, int middle); // 添加或松弛平行边
+    const Arc* findUpArc(int lower, int upper) const; // 查找从低层节点到高层节点的弧
+    void unpack(int from, int to, std::vector<int>& out) const; // 展开捷径（不含起点）
+
+    std::shared_ptr<const CsrGraph> graph;       // 构建索引时的快照
+    std::vector<int> rank;                       // 稠密下标 -> 收缩次序
+    std::vector<int> upOffsets;                  // 向上图的偏移
+    std::vector<Arc> upArcs;                     // 只指向更高层节点的弧
+    int shortcuts;                               // 捷径数
+
+    // 预处理的见证搜索工作区
+    std::vector<double> witnessDist;
+    std::vector<int> witnessTouched;
+    std::vector<char> contracted;
+    IndexedHeap witnessHeap;
+
+    // 查询工作区（正向与反向）
+    std::vector<double> dist[2];
+    std::vector<int> prev[2];
+    std::vector<int> touched[2];
+    IndexedHeap heaps[2];
+};
+
+#endif // CONTRACTIONHIERARCHY_H
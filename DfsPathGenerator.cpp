@@ -0,0 +1,88 @@
+#include "DfsPathGenerator.h"
+#include "Profiler.h"
+
+DfsPathGenerator::DfsPathGenerator(std::shared_ptr<const CsrGraph> graph, int start,
+                                   int maxPaths, int maxDepth)
+    : graph(std::move(graph)), maxPaths(maxPaths), maxDepth(maxDepth), cancelFlag(nullptr) {
+    this->start = this->graph->indexOf(start);
+    restart();
+}
+
+void DfsPathGenerator::restart() {
+    produced = 0;
+    truncated = false;
+    stack.clear();
+    onPath.assign(graph->size(), 0);
+    if (start != -1) {
+        stack.push_back({start, graph->offsets[start], false});
+        onPath[start] = 1;
+    }
+}
+
+int DfsPathGenerator::producedCount() const {
+    return produced;
+}
+
+bool DfsPathGenerator::hitLimit() const {
+    return truncated;
+}
+
+void DfsPathGenerator::setCancelFlag(const std::atomic_bool* flag) {
+    cancelFlag = flag;
+}
+
+bool DfsPathGenerator::next(std::vector<int>& path) {
+    CAMPUS_PROFILE_SCOPE("dfs.next");
+    if (produced >= maxPaths) {
+        truncated = truncated || !stack.empty();
+        return false;
+    }
+
+    while (!stack.empty()) {
+        if (cancelFlag && cancelFlag->load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        Frame& frame = stack.back();
+        int end = graph->offsets[frame.index + 1];
+
+        if (static_cast<int>(stack.size()) < maxDepth) {
+            // 寻找下一个不在当前路径上的邻居
+            while (frame.nextEdge < end && onPath[graph->neighbors[frame.nextEdge]]) {
+                ++frame.nextEdge;
+            }
+            if (frame.nextEdge < end) {
+                int neighbor = graph->neighbors[frame.nextEdge++];
+                frame.extended = true;
+                onPath[neighbor] = 1;
+                stack.push_back({neighbor, graph->offsets[neighbor], false});
+                continue;
+            }
+        } else {
+            // 到达深度上限：若仍有可走的邻居，说明路径被截断
+            for (int e = frame.nextEdge; e < end; ++e) {
+                if (!onPath[graph->neighbors[e]]) {
+                    truncated = true;
+                    break;
+                }
+            }
+        }
+
+        // 当前节点的邻居已全部处理，未扩展过说明是一条极大路径的末端
+        bool report = !frame.extended;
+        if (report) {
+            path.clear();
+            for (const Frame& f : stack) {
+                path.push_back(graph->vexNum(f.index));
+            }
+        }
+        onPath[frame.index] = 0;
+        stack.pop_back();
+
+        if (report) {
+            ++produced;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,42 @@
+#ifndef DFSPATHGENERATOR_H
+#define DFSPATHGENERATOR_H
+
+#include "Graph.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// 惰性的深度优先路径生成器
+// 用显式栈代替递归，每次调用 next() 只推进到下一条极大简单路径
+// （即末端节点再无未访问邻居的路径），可随时暂停和继续；
+// 被取消时栈保持完整，下次调用从中断处继续
+class DfsPathGenerator {
+public:
+    DfsPathGenerator(std::shared_ptr<const CsrGraph> graph, int start,
+                     int maxPaths = 1000, int maxDepth = 64); // 构造函数（start 为节点编号）
+
+    bool next(std::vector<int>& path);           // 生成下一条路径（节点编号），没有更多时返回 false
+    void restart();                              // 从头重新枚举
+    int producedCount() const;                   // 已生成的路径数
+    bool hitLimit() const;                       // 是否因数量或深度上限而截断
+    void setCancelFlag(const std::atomic_bool* flag); // 设置取消标志，置位后 next() 暂停并返回 false
+
+private:
+    struct Frame {
+        int index;                               // 当前节点的稠密下标
+        int nextEdge;                            // 下一条待检查的邻接边
+        bool extended;                           // 是否已向下扩展过
+    };
+
+    std::shared_ptr<const CsrGraph> graph;       // 邻接快照
+    int start;                                   // 起点稠密下标
+    int maxPaths;                                // 最多生成的路径数
+    int maxDepth;                                // 路径最多包含的节点数
+    int produced;                                // 已生成的路径数
+    bool truncated;                              // 是否被上限截断
+    const std::atomic_bool* cancelFlag;          // 取消标志（可为空）
+    std::vector<Frame> stack;                    // 显式搜索栈
+    std::vector<char> onPath;                    // 稠密下标 -> 是否在当前路径上
+};
+
+#endif // DFSPATHGENERATOR_H
@@ -0,0 +1,149 @@
+#include "DistanceMatrix.h"
+#include "IndexedHeap.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <thread>
+
+namespace {
+const double kInfinity = std::numeric_limits<double>::infinity();
+}
+
+DistanceMatrix::DistanceMatrix(std::shared_ptr<const CsrGraph> graph, std::uint64_t edgeVersion,
+                               int threadCount, const std::atomic_bool* cancelFlag)
+    : graph(std::move(graph)), version(edgeVersion), n(this->graph->size()), complete(false), buildMs(0.0) {
+    CAMPUS_PROFILE_SCOPE("apsp.build");
+    auto start = std::chrono::steady_clock::now();
+
+    std::size_t cells = static_cast<std::size_t>(n) * n;
+    distances.assign(cells, std::numeric_limits<float>::infinity());
+    predecessors.assign(cells, -1);
+
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    threadCount = std::max(1, std::min(threadCount, n));
+
+    // 源点由各线程动态领取，每行只由一个线程写入
+    std::atomic_int nextSource(0);
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threadCount; ++t) {
+        workers.emplace_back(&DistanceMatrix::buildRows, this, std::ref(nextSource), cancelFlag);
+    }
+    buildRows(nextSource, cancelFlag);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    complete = !(cancelFlag && cancelFlag->load(std::memory_order_relaxed));
+    buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void DistanceMatrix::buildRows(std::atomic_int& nextSource, const std::atomic_bool* cancelFlag) {
+    const CsrGraph& g = *graph;
+    std::vector<double> dist(n, kInfinity);
+    std::vector<int> touched;
+    IndexedHeap heap(n);
+
+    for (int source = nextSource++; source < n; source = nextSource++) {
+        if (cancelFlag && cancelFlag->load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        float* distRow = &distances[static_cast<std::size_t>(source) * n];
+        int* predRow = &predecessors[static_cast<std::size_t>(source) * n];
+
+        for (int index : touched) {
+            dist[index] = kInfinity;
+        }
+        touched.clear();
+        heap.clear();
+
+        dist[source] = 0.0;
+        touched.push_back(source);
+        heap.push(source, 0.0);
+        while (!heap.empty()) {
+            int current = heap.pop();
+            double base = dist[current];
+            distRow[current] = static_cast<float>(base);
+            for (int e = g.offsets[current]; e < g.offsets[current + 1]; ++e) {
+                int neighbor = g.neighbors[e];
+                double newDist = base + g.weights[e];
+                if (newDist < dist[neighbor]) {
+                    if (dist[neighbor] == kInfinity) touched.push_back(neighbor);
+                    dist[neighbor] = newDist;
+                    predRow[neighbor] = current;
+                    heap.push(neighbor, newDist);
+                }
+            }
+        }
+    }
+}
+
+std::size_t DistanceMatrix::estimateBytes(int vertexCount) {
+    return static_cast<std::size_t>(vertexCount) * vertexCount * (sizeof(float) + sizeof(int));
+}
+
+std::uint64_t DistanceMatrix::edgeVersion() const {
+    return version;
+}
+
+bool DistanceMatrix::isComplete() const {
+    return complete;
+}
+
+float DistanceMatrix::distance(int src, int dst) const {
+    int source = graph->indexOf(src);
+    int target = graph->indexOf(dst);
+    if (source == -1 || target == -1) {
+        return src == dst ? 0.0f : std::numeric_limits<float>::infinity();
+    }
+    return distances[static_cast<std::size_t>(source) * n + target];
+}
+
+double DistanceMatrix::edgeWeight(int from, int to) const {
+    for (int e = graph->offsets[from]; e < graph->offsets[from + 1]; ++e) {
+        if (graph->neighbors[e] == to) {
+            return graph->weights[e];
+        }
+    }
+    return kInfinity;
+}
+
+RouteResult DistanceMatrix::route(int src, int dst) const {
+    RouteResult result;
+    int source = graph->indexOf(src);
+    int target = graph->indexOf(dst);
+    if (source == -1 || target == -1) {
+        return result;
+    }
+
+    std::size_t row = static_cast<std::size_t>(source) * n;
+    if (distances[row + target] == std::numeric_limits<float>::infinity()) {
+        return result;
+    }
+
+    // 沿前驱回溯，并用原始 double 权重累加距离，避免 float 的精度损失
+    std::vector<int> reversedPath;
+    for (int at = target; at != source; at = predecessors[row + at]) {
+        reversedPath.push_back(at);
+        result.distance += edgeWeight(predecessors[row + at], at);
+    }
+    reversedPath.push_back(source);
+
+    result.found = true;
+    result.path.reserve(reversedPath.size());
+    for (auto it = reversedPath.rbegin(); it != reversedPath.rend(); ++it) {
+        result.path.push_back(graph->vexNum(*it));
+    }
+    return result;
+}
+
+std::size_t DistanceMatrix::memoryBytes() const {
+    return distances.capacity() * sizeof(float) + predecessors.capacity() * sizeof(int);
+}
+
+double DistanceMatrix::buildMilliseconds() const {
+    return buildMs;
+}
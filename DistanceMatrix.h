@@ -0,0 +1,45 @@
+#ifndef DISTANCEMATRIX_H
+#define DISTANCEMATRIX_H
+
+#include "Graph.h"
+#include "RoutingEngine.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// 全源最短路径表
+// 构造时用多线程逐源点运行 Dijkstra，距离以 float 紧凑存放，另存前驱矩阵用于还原路径。
+// 占用 n * n * 8 字节，因此只对不超过 kMaxVertices 个节点的图构建
+class DistanceMatrix {
+public:
+    static const int kMaxVertices = 4096;    // 允许构建的最大节点数
+
+    // 构造即构建；edgeVersion 记录构建时图的边版本，用于判断是否过期
+    DistanceMatrix(std::shared_ptr<const CsrGraph> graph, std::uint64_t edgeVersion,
+                   int threadCount = 0, const std::atomic_bool* cancelFlag = nullptr);
+
+    static std::size_t estimateBytes(int vertexCount); // 估算给定节点数所需的内存
+
+    std::uint64_t edgeVersion() const;       // 构建时图的边版本
+    bool isComplete() const;                 // 是否完整构建（未被取消）
+    float distance(int src, int dst) const;  // 查表得到的距离（参数为节点编号，不可达为无穷大）
+    RouteResult route(int src, int dst) const; // 查表并按前驱矩阵还原路径
+    std::size_t memoryBytes() const;         // 表实际占用的内存
+    double buildMilliseconds() const;        // 构建耗时
+
+private:
+    void buildRows(std::atomic_int& nextSource, const std::atomic_bool* cancelFlag); // 工作线程：领取源点并填充对应行
+    double edgeWeight(int from, int to) const; // 相邻两点间的边权
+
+    std::shared_ptr<const CsrGraph> graph;   // 邻接快照
+    std::uint64_t version;
+    int n;
+    std::vector<float> distances;            // distances[s * n + v]：s 到 v 的距离
+    std::vector<int> predecessors;           // predecessors[s * n + v]：以 s 为源时 v 的前驱下标
+    bool complete;
+    double buildMs;
+};
+
+#endif // DISTANCEMATRIX_H
@@ -0,0 +1,434 @@
+#include "DynamicMst.h"
+#include "EdgeStore.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+const double kVertexValue = -std::numeric_limits<double>::infinity(); // 节点结点不参与最大值比较
+}
+
+DynamicMst::DynamicMst() : currentWalk(0), treeWeight(0.0) {}
+
+void DynamicMst::clear() {
+    left.clear();
+    right.clear();
+    parent.clear();
+    reversed.clear();
+    value.clear();
+    maxNode.clear();
+    freeNodes.clear();
+    nodeEdge.clear();
+    vertexNodes.clear();
+    edges.clear();
+    incidence.clear();
+    walkStamp.clear();
+    walkSide.clear();
+    currentWalk = 0;
+    treeWeight = 0.0;
+    changes.clear();
+}
+
+void DynamicMst::build(const std::vector<Edge>& newEdges) {
+    clear();
+
+    // 按权重升序插入时不会发生环替换，等价于一次 Kruskal
+    std::vector<Edge> sorted(newEdges);
+    std::sort(sorted.begin(), sorted.end(), [](const Edge& a, const Edge& b) {
+        return a.weight < b.weight;
+    });
+    edges.reserve(sorted.size());
+    for (const auto& edge : sorted) {
+        insertEdge(edge.vex1, edge.vex2, edge.weight);
+    }
+}
+
+void DynamicMst::insertEdge(int v1, int v2, double weight) {
+    if (v1 == v2) {
+        return;
+    }
+    std::uint64_t key = EdgeStore::packKey(v1, v2);
+    if (edges.count(key)) {
+        updateWeight(v1, v2, weight);
+        return;
+    }
+    auto inserted = edges.emplace(key, EdgeInfo{std::min(v1, v2), std::max(v1, v2), weight, -1, -1, -1});
+    linkIncidence(key, inserted.first->second);
+    placeEdge(key);
+}
+
+void DynamicMst::removeEdge(int v1, int v2) {
+    auto it = edges.find(EdgeStore::packKey(v1, v2));
+    if (it == edges.end()) {
+        return;
+    }
+    unlinkIncidence(it->second);
+    if (it->second.treeNode == -1) {
+        edges.erase(it);
+        return;
+    }
+    detach(it->second);
+    edges.erase(it);
+    reconnect(v1, v2);
+}
+
+void DynamicMst::updateWeight(int v1, int v2, double weight) {
+    std::uint64_t key = EdgeStore::packKey(v1, v2);
+    auto it = edges.find(key);
+    if (it == edges.end()) {
+        return;
+    }
+    EdgeInfo& info = it->second;
+    double old = info.weight;
+
+    if (info.treeNode != -1) {
+        if (weight <= old) {
+            // 树边变轻后森林仍然最小，只需更新结点上的权重
+            int e = info.treeNode;
+            access(e);
+            value[e] = weight;
+            pull(e);
+            info.weight = weight;
+            treeWeight += weight - old;
+        } else {
+            // 树边变重：先移出森林，再在所有跨越两棵子树的边（含它自己）中取最轻的
+            detach(info);
+            info.weight = weight;
+            reconnect(info.v1, info.v2);
+        }
+        return;
+    }
+
+    info.weight = weight;
+    if (weight < old) {
+        placeEdge(key); // 非树边变重不影响森林
+    }
+}
+
+bool DynamicMst::isTreeEdge(int v1, int v2) const {
+    auto it = edges.find(EdgeStore::packKey(v1, v2));
+    return it != edges.end() && it->second.treeNode != -1;
+}
+
+std::vector<Edge> DynamicMst::treeEdges() const {
+    std::vector<Edge> result;
+    for (const auto& pair : edges) {
+        if (pair.second.treeNode != -1) {
+            result.push_back({pair.second.v1, pair.second.v2, pair.second.weight});
+        }
+    }
+    return result;
+}
+
+double DynamicMst::totalWeight() const {
+    return treeWeight;
+}
+
+std::vector<DynamicMst::Change> DynamicMst::takeChanges() {
+    std::vector<Change> result;
+    result.swap(changes);
+    return result;
+}
+
+void DynamicMst::placeEdge(std::uint64_t key) {
+    EdgeInfo& info = edges.at(key);
+    int a = vertexNode(info.v1);
+    int b = vertexNode(info.v2);
+    if (!connected(a, b)) {
+        attach(key, info);
+        return;
+    }
+
+    // 两端已连通：与环上最重的树边比较，更轻则替换
+    int heaviest = pathMax(a, b);
+    if (value[heaviest] > info.weight) {
+        std::uint64_t oldKey = nodeEdge[heaviest];
+        EdgeInfo& old = edges.at(oldKey);
+        detach(old);
+        attach(key, info);
+    }
+}
+
+void DynamicMst::reconnect(int v1, int v2) {
+    // 新的一轮遍历；轮次回绕时清空旧标记
+    if (++currentWalk == 0) {
+        std::fill(walkStamp.begin(), walkStamp.end(), 0u);
+        currentWalk = 1;
+    }
+    walkStamp.resize(incidence.size(), 0u);
+    walkSide.resize(incidence.size(), 0);
+
+    const int ends[2] = {v1, v2};
+    for (int side = 0; side < 2; ++side) {
+        TreeWalk& walk = walks[side];
+        walk.queue.clear();
+        walk.queue.push_back(ends[side]);
+        walk.head = 0;
+        walk.cursor = 0;
+        walkStamp[ends[side]] = currentWalk;
+        walkSide[ends[side]] = static_cast<char>(side);
+    }
+
+    // 两侧交替前进，先遍历完的一侧就是较小的子树（按关联边数计）
+    int side = 0;
+    while (true) {
+        if (!stepWalk(walks[0], 0)) {
+            side = 0;
+            break;
+        }
+        if (!stepWalk(walks[1], 1)) {
+            side = 1;
+            break;
+        }
+    }
+
+    // 森林中的非树边总在同一棵树内，所以较小子树上另一端不在本侧的非树边都能重新连通两侧
+    std::uint64_t bestKey = 0;
+    EdgeInfo* best = nullptr;
+    for (int u : walks[side].queue) {
+        for (std::uint64_t key : incidence[u]) {
+            EdgeInfo& info = edges.at(key);
+            if (info.treeNode != -1) {
+                continue;
+            }
+            int other = info.v1 == u ? info.v2 : info.v1;
+            if (onSide(other, side)) {
+                continue;
+            }
+            if (!best || info.weight < best->weight) {
+                best = &info;
+                bestKey = key;
+            }
+        }
+    }
+    if (best) {
+        attach(bestKey, *best);
+    }
+}
+
+bool DynamicMst::stepWalk(TreeWalk& walk, int side) {
+    while (walk.head < walk.queue.size()) {
+        int u = walk.queue[walk.head];
+        const std::vector<std::uint64_t>& list = incidence[u];
+        if (walk.cursor >= list.size()) {
+            ++walk.head;
+            walk.cursor = 0;
+            continue;
+        }
+        const EdgeInfo& info = edges.at(list[walk.cursor++]);
+        if (info.treeNode != -1) {
+            int other = info.v1 == u ? info.v2 : info.v1;
+            if (!onSide(other, side)) {
+                walkStamp[other] = currentWalk;
+                walkSide[other] = static_cast<char>(side);
+                walk.queue.push_back(other);
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+bool DynamicMst::onSide(int vexNum, int side) const {
+    return walkStamp[vexNum] == currentWalk && walkSide[vexNum] == side;
+}
+
+void DynamicMst::linkIncidence(std::uint64_t key, EdgeInfo& info) {
+    int top = std::max(info.v1, info.v2);
+    if (top >= static_cast<int>(incidence.size())) {
+        incidence.resize(top + 1);
+    }
+    info.pos1 = static_cast<int>(incidence[info.v1].size());
+    incidence[info.v1].push_back(key);
+    info.pos2 = static_cast<int>(incidence[info.v2].size());
+    incidence[info.v2].push_back(key);
+}
+
+void DynamicMst::unlinkIncidence(const EdgeInfo& info) {
+    const int ends[2] = {info.v1, info.v2};
+    const int positions[2] = {info.pos1, info.pos2};
+    for (int i = 0; i < 2; ++i) {
+        std::vector<std::uint64_t>& list = incidence[ends[i]];
+        int pos = positions[i];
+        // 把表尾的边移到空位，并修正它记录的位置
+        std::uint64_t moved = list.back();
+        list[pos] = moved;
+        list.pop_back();
+        if (pos < static_cast<int>(list.size())) {
+            EdgeInfo& movedInfo = edges.at(moved);
+            if (movedInfo.v1 == ends[i]) {
+                movedInfo.pos1 = pos;
+            } else {
+                movedInfo.pos2 = pos;
+            }
+        }
+    }
+}
+
+void DynamicMst::attach(std::uint64_t key, EdgeInfo& info) {
+    int e = allocNode(info.weight);
+    nodeEdge[e] = key;
+    info.treeNode = e;
+    link(vertexNode(info.v1), e);
+    link(e, vertexNode(info.v2));
+    treeWeight += info.weight;
+    changes.push_back({info.v1, info.v2, true});
+}
+
+void DynamicMst::detach(EdgeInfo& info) {
+    int e = info.treeNode;
+    cut(vertexNode(info.v1), e);
+    cut(e, vertexNode(info.v2));
+    freeNodes.push_back(e);
+    info.treeNode = -1;
+    treeWeight -= info.weight;
+    changes.push_back({info.v1, info.v2, false});
+}
+
+int DynamicMst::vertexNode(int vexNum) {
+    if (vexNum >= static_cast<int>(vertexNodes.size())) {
+        vertexNodes.resize(vexNum + 1, -1);
+    }
+    if (vertexNodes[vexNum] == -1) {
+        vertexNodes[vexNum] = allocNode(kVertexValue);
+    }
+    return vertexNodes[vexNum];
+}
+
+int DynamicMst::allocNode(double nodeValue) {
+    int x;
+    if (!freeNodes.empty()) {
+        x = freeNodes.back();
+        freeNodes.pop_back();
+    } else {
+        x = static_cast<int>(value.size());
+        left.push_back(-1);
+        right.push_back(-1);
+        parent.push_back(-1);
+        reversed.push_back(0);
+        value.push_back(0.0);
+        maxNode.push_back(x);
+        nodeEdge.push_back(0);
+    }
+    left[x] = right[x] = parent[x] = -1;
+    reversed[x] = 0;
+    value[x] = nodeValue;
+    maxNode[x] = x;
+    return x;
+}
+
+bool DynamicMst::isRoot(int x) const {
+    int p = parent[x];
+    return p == -1 || (left[p] != x && right[p] != x);
+}
+
+void DynamicMst::pull(int x) {
+    int best = x;
+    if (left[x] != -1 && value[maxNode[left[x]]] > value[best]) best = maxNode[left[x]];
+    if (right[x] != -1 && value[maxNode[right[x]]] > value[best]) best = maxNode[right[x]];
+    maxNode[x] = best;
+}
+
+void DynamicMst::push(int x) {
+    if (reversed[x]) {
+        std::swap(left[x], right[x]);
+        if (left[x] != -1) reversed[left[x]] ^= 1;
+        if (right[x] != -1) reversed[right[x]] ^= 1;
+        reversed[x] = 0;
+    }
+}
+
+void DynamicMst::rotate(int x) {
+    int p = parent[x];
+    int g = parent[p];
+    bool pIsRoot = isRoot(p);
+    if (left[p] == x) {
+        left[p] = right[x];
+        if (right[x] != -1) parent[right[x]] = p;
+        right[x] = p;
+    } else {
+        right[p] = left[x];
+        if (left[x] != -1) parent[left[x]] = p;
+        left[x] = p;
+    }
+    parent[p] = x;
+    parent[x] = g;
+    if (!pIsRoot) {
+        if (left[g] == p) left[g] = x;
+        else right[g] = x;
+    }
+    pull(p);
+    pull(x);
+}
+
+void DynamicMst::splay(int x) {
+    // 自上而下下推翻转标记
+    splayPath.clear();
+    for (int y = x;; y = parent[y]) {
+        splayPath.push_back(y);
+        if (isRoot(y)) break;
+    }
+    for (auto it = splayPath.rbegin(); it != splayPath.rend(); ++it) {
+        push(*it);
+    }
+
+    while (!isRoot(x)) {
+        int p = parent[x];
+        if (!isRoot(p)) {
+            int g = parent[p];
+            bool zigZig = (left[g] == p) == (left[p] == x);
+            rotate(zigZig ? p : x);
+        }
+        rotate(x);
+    }
+}
+
+void DynamicMst::access(int x) {
+    int last = -1;
+    for (int y = x; y != -1; y = parent[y]) {
+        splay(y);
+        right[y] = last;
+        pull(y);
+        last = y;
+    }
+    splay(x);
+}
+
+void DynamicMst::makeRoot(int x) {
+    access(x);
+    reversed[x] ^= 1;
+}
+
+int DynamicMst::findRoot(int x) {
+    access(x);
+    push(x);
+    while (left[x] != -1) {
+        x = left[x];
+        push(x);
+    }
+    splay(x);
+    return x;
+}
+
+bool DynamicMst::connected(int a, int b) {
+    return findRoot(a) == findRoot(b);
+}
+
+void DynamicMst::link(int a, int b) {
+    makeRoot(a);
+    parent[a] = b;
+}
+
+void DynamicMst::cut(int a, int b) {
+    makeRoot(a);
+    access(b);
+    // a 与 b 相邻，此时 a 是 b 在伸展树中的左孩子
+    left[b] = -1;
+    parent[a] = -1;
+    pull(b);
+}
+
+int DynamicMst::pathMax(int a, int b) {
+    makeRoot(a);
+    access(b);
+    return maxNode[b];
+}
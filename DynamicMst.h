@@ -0,0 +1,98 @@
+#ifndef DYNAMICMST_H
+#define DYNAMICMST_H
+
+#include "Graph.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// 动态最小生成森林
+// 用 link-cut tree 维护森林：每个节点和每条树边各对应一个树结点，边结点携带权重，
+// 路径最大值查询即可找到环上最重的边。插入边时做环替换；删除树边时从两端交替
+// 遍历树边，只在较小的那棵子树关联的非树边中寻找最轻的替代边
+class DynamicMst {
+public:
+    struct Change {
+        int v1;                              // 较小的节点编号
+        int v2;                              // 较大的节点编号
+        bool added;                          // true 表示进入森林，false 表示离开森林
+    };
+
+    DynamicMst();                            // 构造函数
+    void clear();                            // 清空所有边
+    void build(const std::vector<Edge>& edges); // 清空后用给定的边重建（树边全部记为新增）
+    void insertEdge(int v1, int v2, double weight); // 插入一条边（已存在时等价于修改权重）
+    void removeEdge(int v1, int v2);         // 删除一条边
+    void updateWeight(int v1, int v2, double weight); // 修改边的权重
+
+    bool isTreeEdge(int v1, int v2) const;   // 边是否在当前森林中
+    std::vector<Edge> treeEdges() const;     // 当前森林中的所有边
+    double totalWeight() const;              // 当前森林的总权重
+    std::vector<Change> takeChanges();       // 取出自上次调用以来森林中边的增减
+
+private:
+    struct EdgeInfo {
+        int v1;
+        int v2;
+        double weight;
+        int treeNode;                        // 对应的树结点（非树边为 -1）
+        int pos1;                            // 在 v1 关联边表中的位置
+        int pos2;                            // 在 v2 关联边表中的位置
+    };
+
+    // 在树边上做广度优先遍历的游标，用于交替探索切断后的两棵子树
+    struct TreeWalk {
+        std::vector<int> queue;              // 已访问的节点（即当前探索到的子树）
+        std::size_t head = 0;                // 正在展开的节点在 queue 中的下标
+        std::size_t cursor = 0;              // 正在检查的关联边下标
+    };
+
+    // link-cut tree 的基本操作
+    bool isRoot(int x) const;
+    void pull(int x);
+    void push(int x);
+    void rotate(int x);
+    void splay(int x);
+    void access(int x);
+    void makeRoot(int x);
+    int findRoot(int x);
+    bool connected(int a, int b);
+    void link(int a, int b);
+    void cut(int a, int b);
+    int pathMax(int a, int b);               // a 到 b 路径上权重最大的边结点
+
+    int vertexNode(int vexNum);              // 节点编号 -> 树结点（按需分配）
+    int allocNode(double value);
+    void attach(std::uint64_t key, EdgeInfo& info); // 把边加入森林
+    void detach(EdgeInfo& info);             // 把边移出森林
+    void placeEdge(std::uint64_t key);       // 为不在森林中的边做环替换
+    void reconnect(int v1, int v2);          // 删除树边后寻找替代边
+    void linkIncidence(std::uint64_t key, EdgeInfo& info);   // 把边登记到两端的关联边表
+    void unlinkIncidence(const EdgeInfo& info);              // 从两端的关联边表中移除（交换删除）
+    bool stepWalk(TreeWalk& walk, int side); // 前进一条关联边，子树遍历完毕时返回 false
+    bool onSide(int vexNum, int side) const; // 节点是否已被本次遍历的 side 一侧访问
+
+    // 树结点数组
+    std::vector<int> left;
+    std::vector<int> right;
+    std::vector<int> parent;
+    std::vector<char> reversed;
+    std::vector<double> value;               // 边结点为权重，节点结点为 -inf
+    std::vector<int> maxNode;                // 子树中权重最大的结点
+    std::vector<int> freeNodes;              // 回收的边结点
+    std::vector<std::uint64_t> nodeEdge;     // 边结点 -> 边的键
+    std::vector<int> splayPath;              // 伸展前下推标记用的临时栈
+
+    std::vector<int> vertexNodes;            // 节点编号 -> 树结点（未分配为 -1）
+    std::unordered_map<std::uint64_t, EdgeInfo> edges; // 所有边
+    std::vector<std::vector<std::uint64_t>> incidence; // 节点编号 -> 关联边的键（树边与非树边）
+    std::vector<unsigned> walkStamp;         // 节点最近一次被遍历时的轮次
+    std::vector<char> walkSide;              // 节点在该轮次中属于哪一侧
+    unsigned currentWalk;                    // 当前遍历轮次
+    TreeWalk walks[2];                       // 两侧的遍历游标（复用缓冲区）
+    double treeWeight;
+    std::vector<Change> changes;
+};
+
+#endif // DYNAMICMST_H
@@ -0,0 +1,249 @@
+#include "EdgeLayerItem.h"
+#include "graphicsview.h"
+#include "Profiler.h"
+#include <QPainter>
+#include <QPen>
+#include <QStyleOptionGraphicsItem>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+const QSizeF kLabelSize(80, 20);   // 权重标签的预留区域
+const qreal kPenMargin = 2;        // 线宽留出的边距
+const qreal kCellSize = 128;       // 网格索引的格子边长（场景坐标）
+}
+
+EdgeLayerItem::EdgeLayerItem(QGraphicsItem* parent)
+    : QGraphicsItem(parent), currentStamp(0) {
+    // 只重绘暴露区域，paint() 据此跳过不可见的边
+    setFlag(ItemUsesExtendedStyleOption);
+    setZValue(-1);
+}
+
+quint64 EdgeLayerItem::edgeKey(int v1, int v2) {
+    quint32 minV = static_cast<quint32>(std::min(v1, v2));
+    quint32 maxV = static_cast<quint32>(std::max(v1, v2));
+    return (static_cast<quint64>(minV) << 32) | maxV;
+}
+
+void EdgeLayerItem::setEdge(int v1, int v2, const QPointF& p1, const QPointF& p2, double weight) {
+    quint64 key = edgeKey(v1, v2);
+    QString label = QString::number(weight, 'f', 2);
+
+    auto it = slots.find(key);
+    if (it == slots.end()) {
+        int slot = static_cast<int>(lines.size());
+        slots[key] = slot;
+        lines.push_back(QLineF(p1, p2));
+        labels.push_back(label);
+        keys.push_back(key);
+        slotCells.push_back(QRect());
+        visitStamps.push_back(0);
+        QRectF rect = edgeRect(slot);
+        indexSlot(slot);
+        growBounds(rect);
+        update(rect);
+        return;
+    }
+
+    int slot = it->second;
+    QRectF oldRect = edgeRect(slot);
+    lines[slot] = QLineF(p1, p2);
+    labels[slot] = label;
+    QRectF newRect = edgeRect(slot);
+    // 覆盖的格子不变时（拖动中的常见情况）无需改动索引
+    if (cellRange(newRect) != slotCells[slot]) {
+        unindexSlot(slot);
+        indexSlot(slot);
+    }
+    growBounds(newRect);
+    update(oldRect | newRect);
+}
+
+void EdgeLayerItem::removeEdge(int v1, int v2) {
+    auto it = slots.find(edgeKey(v1, v2));
+    if (it == slots.end()) {
+        return;
+    }
+
+    // 与末尾元素交换后删除，保持数组紧凑
+    int slot = it->second;
+    int last = static_cast<int>(lines.size()) - 1;
+    update(edgeRect(slot));
+    unindexSlot(slot);
+    slots.erase(it);
+    if (slot != last) {
+        renumberSlot(last, slot);
+        lines[slot] = lines[last];
+        labels[slot] = labels[last];
+        keys[slot] = keys[last];
+        slotCells[slot] = slotCells[last];
+        slots[keys[slot]] = slot;
+    }
+    lines.pop_back();
+    labels.pop_back();
+    keys.pop_back();
+    slotCells.pop_back();
+    visitStamps.pop_back();
+}
+
+bool EdgeLayerItem::hasEdge(int v1, int v2) const {
+    return slots.find(edgeKey(v1, v2)) != slots.end();
+}
+
+void EdgeLayerItem::clearEdges() {
+    prepareGeometryChange();
+    lines.clear();
+    labels.clear();
+    keys.clear();
+    slots.clear();
+    slotCells.clear();
+    cells.clear();
+    visitStamps.clear();
+    bounds = QRectF();
+}
+
+int EdgeLayerItem::edgeCount() const {
+    return static_cast<int>(lines.size());
+}
+
+QRectF EdgeLayerItem::edgeRect(int slot) const {
+    const QLineF& line = lines[slot];
+    QRectF rect = QRectF(line.p1(), line.p2()).normalized();
+    rect |= QRectF(line.center(), kLabelSize);
+    return rect.adjusted(-kPenMargin, -kPenMargin, kPenMargin, kPenMargin);
+}
+
+void EdgeLayerItem::growBounds(const QRectF& rect) {
+    if (!bounds.contains(rect)) {
+        prepareGeometryChange();
+        bounds = bounds.isNull() ? rect : (bounds | rect);
+    }
+}
+
+QRect EdgeLayerItem::cellRange(const QRectF& rect) const {
+    return QRect(QPoint(static_cast<int>(std::floor(rect.left() / kCellSize)),
+                        static_cast<int>(std::floor(rect.top() / kCellSize))),
+                 QPoint(static_cast<int>(std::floor(rect.right() / kCellSize)),
+                        static_cast<int>(std::floor(rect.bottom() / kCellSize))));
+}
+
+quint64 EdgeLayerItem::cellKey(int cx, int cy) {
+    return (static_cast<quint64>(static_cast<quint32>(cx)) << 32) | static_cast<quint32>(cy);
+}
+
+void EdgeLayerItem::indexSlot(int slot) {
+    QRect range = cellRange(edgeRect(slot));
+    slotCells[slot] = range;
+    for (int cx = range.left(); cx <= range.right(); ++cx) {
+        for (int cy = range.top(); cy <= range.bottom(); ++cy) {
+            cells[cellKey(cx, cy)].push_back(slot);
+        }
+    }
+}
+
+void EdgeLayerItem::unindexSlot(int slot) {
+    const QRect& range = slotCells[slot];
+    for (int cx = range.left(); cx <= range.right(); ++cx) {
+        for (int cy = range.top(); cy <= range.bottom(); ++cy) {
+            auto cell = cells.find(cellKey(cx, cy));
+            if (cell == cells.end()) continue;
+            std::vector<int>& members = cell->second;
+            auto pos = std::find(members.begin(), members.end(), slot);
+            if (pos != members.end()) {
+                *pos = members.back();
+                members.pop_back();
+            }
+            if (members.empty()) {
+                cells.erase(cell);
+            }
+        }
+    }
+}
+
+void EdgeLayerItem::renumberSlot(int from, int to) {
+    const QRect& range = slotCells[from];
+    for (int cx = range.left(); cx <= range.right(); ++cx) {
+        for (int cy = range.top(); cy <= range.bottom(); ++cy) {
+            std::vector<int>& members = cells[cellKey(cx, cy)];
+            std::replace(members.begin(), members.end(), from, to);
+        }
+    }
+}
+
+std::vector<int> EdgeLayerItem::visibleSlots(const QRectF& exposed) const {
+    std::vector<int> visible;
+    QRectF area = exposed & bounds;
+    if (area.isEmpty()) {
+        return visible;
+    }
+
+    // 每次查询换一个标记值，跨多个格子的边只收集一次
+    if (++currentStamp == 0) {
+        std::fill(visitStamps.begin(), visitStamps.end(), 0);
+        currentStamp = 1;
+    }
+    auto collect = [&](const std::vector<int>& members) {
+        for (int slot : members) {
+            if (visitStamps[slot] != currentStamp) {
+                visitStamps[slot] = currentStamp;
+                if (edgeRect(slot).intersects(exposed)) {
+                    visible.push_back(slot);
+                }
+            }
+        }
+    };
+
+    // 查询范围的格子数多于非空格子数时（缩得很小），直接遍历非空格子
+    QRect range = cellRange(area);
+    if (static_cast<qint64>(range.width()) * range.height() > static_cast<qint64>(cells.size())) {
+        for (const auto& cell : cells) {
+            int cx = static_cast<int>(static_cast<quint32>(cell.first >> 32));
+            int cy = static_cast<int>(static_cast<quint32>(cell.first));
+            if (range.contains(cx, cy)) {
+                collect(cell.second);
+            }
+        }
+    } else {
+        for (int cx = range.left(); cx <= range.right(); ++cx) {
+            for (int cy = range.top(); cy <= range.bottom(); ++cy) {
+                auto cell = cells.find(cellKey(cx, cy));
+                if (cell != cells.end()) {
+                    collect(cell->second);
+                }
+            }
+        }
+    }
+    return visible;
+}
+
+QRectF EdgeLayerItem::boundingRect() const {
+    return bounds;
+}
+
+void EdgeLayerItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
+    CAMPUS_PROFILE_SCOPE("scene.paintEdges");
+    Q_UNUSED(widget);
+    const QRectF& exposed = option->exposedRect;
+
+    // 先从网格索引中取出与暴露区域相交的边，再一次性画出所有线段
+    std::vector<int> visible = visibleSlots(exposed);
+
+    std::vector<QLineF> batch;
+    batch.reserve(visible.size());
+    for (int slot : visible) {
+        batch.push_back(lines[slot]);
+    }
+    painter->setPen(QPen(Qt::gray, 2));
+    painter->drawLines(batch.data(), static_cast<int>(batch.size()));
+
+    // 同一遍中绘制权重标签；缩小到看不清时直接跳过
+    qreal lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    if (lod < GraphicsView::kLabelLodThreshold) {
+        return;
+    }
+    painter->setPen(Qt::blue);
+    for (int slot : visible) {
+        painter->drawText(QRectF(lines[slot].center(), kLabelSize), Qt::AlignLeft | Qt::AlignTop, labels[slot]);
+    }
+}
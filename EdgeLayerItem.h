@@ -0,0 +1,51 @@
+#ifndef EDGELAYERITEM_H
+#define EDGELAYERITEM_H
+
+#include <QGraphicsItem>
+#include <QLineF>
+#include <QRect>
+#include <QString>
+#include <unordered_map>
+#include <vector>
+
+// 批量绘制所有普通边的图元
+// 边的端点、权重和标签文本紧凑存放在数组中，一次 paint() 画出全部线段和权重，
+// 取代每条边一个 QGraphicsLineItem 加一个 QGraphicsTextItem 的做法。
+// 另有一张均匀网格索引记录每个格子覆盖到的边，paint() 只查询与暴露区域重叠的格子，
+// 重绘代价与可见部分而不是整张图的规模成正比
+class EdgeLayerItem : public QGraphicsItem {
+public:
+    explicit EdgeLayerItem(QGraphicsItem* parent = nullptr);
+
+    void setEdge(int v1, int v2, const QPointF& p1, const QPointF& p2, double weight); // 添加或更新一条边
+    void removeEdge(int v1, int v2);             // 删除一条边
+    bool hasEdge(int v1, int v2) const;          // 边是否存在
+    void clearEdges();                           // 删除所有边
+    int edgeCount() const;                       // 边数
+
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
+
+private:
+    static quint64 edgeKey(int v1, int v2);      // 无向边的64位键
+    QRectF edgeRect(int slot) const;             // 一条边（含权重标签）占用的区域
+    void growBounds(const QRectF& rect);         // 扩大包围盒
+    QRect cellRange(const QRectF& rect) const;   // 区域覆盖的格子范围（含两端）
+    static quint64 cellKey(int cx, int cy);      // 格子坐标的64位键
+    void indexSlot(int slot);                    // 把边登记到它覆盖的格子
+    void unindexSlot(int slot);                  // 从它覆盖的格子中移除边
+    void renumberSlot(int from, int to);         // 边的下标变化时更新格子中的记录
+    std::vector<int> visibleSlots(const QRectF& exposed) const; // 与区域相交的边
+
+    std::vector<QLineF> lines;                   // 紧凑的线段数组
+    std::vector<QString> labels;                 // 与 lines 对应的权重文本
+    std::vector<quint64> keys;                   // 与 lines 对应的边键
+    std::unordered_map<quint64, int> slots;      // 边键 -> 数组下标
+    std::vector<QRect> slotCells;                // 与 lines 对应的覆盖格子范围
+    std::unordered_map<quint64, std::vector<int>> cells; // 格子键 -> 覆盖该格子的边下标
+    mutable std::vector<quint32> visitStamps;    // 查询时去重用的标记（每条边一个）
+    mutable quint32 currentStamp;
+    QRectF bounds;                               // 只增不减的包围盒，避免每次移动都重算
+};
+
+#endif // EDGELAYERITEM_H
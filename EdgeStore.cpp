@@ -0,0 +1,147 @@
+#include "EdgeStore.h"
+#include <algorithm>
+
+std::uint64_t EdgeStore::packKey(int v1, int v2) {
+    std::uint32_t minV = static_cast<std::uint32_t>(std::min(v1, v2));
+    std::uint32_t maxV = static_cast<std::uint32_t>(std::max(v1, v2));
+    return (static_cast<std::uint64_t>(minV) << 32) | maxV;
+}
+
+std::uint64_t EdgeStore::hash(std::uint64_t key) {
+    // splitmix64 的混合步骤，打散连续编号
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return key;
+}
+
+std::uint64_t EdgeStore::keyAt(int recordIndex) const {
+    const Record& record = edges[recordIndex];
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(record.v1)) << 32) |
+           static_cast<std::uint32_t>(record.v2);
+}
+
+size_t EdgeStore::findSlot(std::uint64_t key) const {
+    size_t mask = slots.size() - 1;
+    size_t slot = hash(key) & mask;
+    while (slots[slot] != -1 && keyAt(slots[slot]) != key) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void EdgeStore::rehash(size_t capacity) {
+    size_t newSize = 16;
+    while (newSize < capacity * 2) {
+        newSize <<= 1;
+    }
+    slots.assign(newSize, -1);
+    for (int i = 0; i < static_cast<int>(edges.size()); ++i) {
+        slots[findSlot(keyAt(i))] = i;
+    }
+}
+
+void EdgeStore::reserve(size_t count) {
+    edges.reserve(count);
+    if (slots.size() < count * 2) {
+        rehash(count);
+    }
+}
+
+void EdgeStore::clear() {
+    edges.clear();
+    slots.clear();
+}
+
+size_t EdgeStore::size() const {
+    return edges.size();
+}
+
+bool EdgeStore::empty() const {
+    return edges.empty();
+}
+
+bool EdgeStore::contains(int v1, int v2) const {
+    return find(v1, v2) != nullptr;
+}
+
+const double* EdgeStore::find(int v1, int v2) const {
+    if (slots.empty()) {
+        return nullptr;
+    }
+    size_t slot = findSlot(packKey(v1, v2));
+    return slots[slot] == -1 ? nullptr : &edges[slots[slot]].weight;
+}
+
+bool EdgeStore::insertOrAssign(int v1, int v2, double weight) {
+    // 负载因子保持在 1/2 以下，线性探测链较短
+    if ((edges.size() + 1) * 2 > slots.size()) {
+        rehash(std::max<size_t>(edges.size() + 1, edges.size() * 2));
+    }
+
+    std::uint64_t key = packKey(v1, v2);
+    size_t slot = findSlot(key);
+    if (slots[slot] != -1) {
+        edges[slots[slot]].weight = weight;
+        return false;
+    }
+
+    slots[slot] = static_cast<int>(edges.size());
+    edges.push_back({std::min(v1, v2), std::max(v1, v2), weight});
+    return true;
+}
+
+bool EdgeStore::assign(int v1, int v2, double weight) {
+    if (slots.empty()) {
+        return false;
+    }
+    size_t slot = findSlot(packKey(v1, v2));
+    if (slots[slot] == -1) {
+        return false;
+    }
+    edges[slots[slot]].weight = weight;
+    return true;
+}
+
+bool EdgeStore::erase(int v1, int v2) {
+    if (slots.empty()) {
+        return false;
+    }
+    size_t mask = slots.size() - 1;
+    size_t slot = findSlot(packKey(v1, v2));
+    int recordIndex = slots[slot];
+    if (recordIndex == -1) {
+        return false;
+    }
+
+    // 向后移位删除：把探测链上后续的项前移，不留墓碑
+    size_t hole = slot;
+    size_t next = (hole + 1) & mask;
+    while (slots[next] != -1) {
+        size_t home = hash(keyAt(slots[next])) & mask;
+        // home 不在 (hole, next] 区间内时，该项可以移到空位
+        bool movable = hole <= next ? (home <= hole || home > next) : (home <= hole && home > next);
+        if (movable) {
+            slots[hole] = slots[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    slots[hole] = -1;
+
+    // 用末尾记录填补被删除的记录，并修正其槽位
+    int last = static_cast<int>(edges.size()) - 1;
+    if (recordIndex != last) {
+        size_t lastSlot = findSlot(keyAt(last));
+        edges[recordIndex] = edges[last];
+        slots[lastSlot] = recordIndex;
+    }
+    edges.pop_back();
+    return true;
+}
+
+const std::vector<EdgeStore::Record>& EdgeStore::records() const {
+    return edges;
+}
@@ -0,0 +1,42 @@
+#ifndef EDGESTORE_H
+#define EDGESTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 无向边的扁平存储
+// 边记录紧凑存放在数组中（每条 16 字节），另用开放寻址哈希表按 (小编号, 大编号)
+// 打包成的 64 位键定位记录下标；删除时用末尾记录填补空位，遍历即线性扫描
+class EdgeStore {
+public:
+    struct Record {
+        int v1;                              // 较小的节点编号
+        int v2;                              // 较大的节点编号
+        double weight;                       // 边的权重
+    };
+
+    static std::uint64_t packKey(int v1, int v2); // 打包无向边的键（与端点顺序无关）
+
+    void reserve(size_t count);              // 预留容量，避免批量插入时反复扩容
+    void clear();                            // 清空所有边
+    size_t size() const;                     // 边数
+    bool empty() const;                      // 是否没有边
+    bool contains(int v1, int v2) const;     // 边是否存在
+    const double* find(int v1, int v2) const; // 查找权重，不存在返回 nullptr
+    bool insertOrAssign(int v1, int v2, double weight); // 插入或覆盖权重，新插入返回 true
+    bool assign(int v1, int v2, double weight); // 仅当边存在时更新权重
+    bool erase(int v1, int v2);              // 删除一条边，不存在返回 false
+    const std::vector<Record>& records() const; // 全部边记录（顺序不保证）
+
+private:
+    static std::uint64_t hash(std::uint64_t key);
+    std::uint64_t keyAt(int recordIndex) const;
+    size_t findSlot(std::uint64_t key) const; // 返回键所在的槽位，不存在返回空槽位
+    void rehash(size_t capacity);
+
+    std::vector<Record> edges;               // 紧凑的边记录
+    std::vector<int> slots;                  // 哈希槽位 -> 记录下标（空槽为 -1），容量为 2 的幂
+};
+
+#endif // EDGESTORE_H
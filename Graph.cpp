@@ -1,34 +1,51 @@
 #include "Graph.h"
+#include "Profiler.h"
 #include <cmath>
 #include <algorithm>
 
-Graph::Graph() : vexCounter(0) {}
+Graph::Graph() : vexCounter(0), bulkActive(false), mutations(0), edgeMutations(0), csrDirty(true) {}
 
 int Graph::insertVex(const Vex& vex) {
     // 检查名称唯一性
-    for (const auto& [id, existingVex] : vexs) {
-        if (existingVex.name == vex.name) {
-            return -1; // 名称重复
-        }
+    std::string key = trimName(vex.name);
+    if (nameIndex.find(key) != nameIndex.end()) {
+        return -1; // 名称重复
     }
 
     int num = vexCounter++;
     Vex newVex = vex;
     newVex.num = num;
     vexs[num] = newVex;
+    incidence.resize(vexCounter);
+    incidencePositions.resize(vexCounter);
+    nameIndex.emplace(std::move(key), num);
+    markDirty();
     return num;
 }
 
-bool Graph::removeVex(int vexNum) {
-    if (vexs.erase(vexNum)) {
-        // 移除与该节点相关的边
-        for (auto it = edges.begin(); it != edges.end();) {
-            if (it->first == vexNum || it->second == vexNum) {
-                edgeWeights.erase(*it);
-                it = edges.erase(it);
-            } else {
-                ++it;
+bool Graph::removeVex(int vexNum, std::vector<Edge>* removedEdges) {
+    auto vexIt = vexs.find(vexNum);
+    if (vexIt != vexs.end()) {
+        nameIndex.erase(trimName(vexIt->second.name));
+        vexs.erase(vexIt);
+
+        // 只遍历该节点的关联表移除相关的边；对端表项的位置已记录，每条边 O(1)
+        bool hadEdges = !incidence[vexNum].empty();
+        for (size_t i = 0; i < incidence[vexNum].size(); ++i) {
+            int neighbor = incidence[vexNum][i];
+            if (removedEdges) {
+                removedEdges->push_back({std::min(vexNum, neighbor), std::max(vexNum, neighbor),
+                                         *edges.find(vexNum, neighbor)});
             }
+            edges.erase(vexNum, neighbor);
+            eraseIncidenceAt(neighbor, incidencePositions[vexNum][i]);
+        }
+        std::vector<int>().swap(incidence[vexNum]);
+        std::vector<int>().swap(incidencePositions[vexNum]);
+        if (hadEdges) {
+            markEdgesDirty();
+        } else {
+            markDirty();
         }
         return true;
     }
@@ -37,44 +54,128 @@ bool Graph::removeVex(int vexNum) {
 
 void Graph::clearEdges() {
     edges.clear();
-    edgeWeights.clear();
+    for (auto& list : incidence) {
+        list.clear();
+    }
+    for (auto& list : incidencePositions) {
+        list.clear();
+    }
+    markEdgesDirty();
 }
 
 void Graph::clearGraph() {
     vexs.clear();
+    pendingEdges.clear();
+    nameIndex.clear();
     edges.clear();
-    edgeWeights.clear();
+    incidence.clear();
+    incidencePositions.clear();
     vexCounter = 0; // 重置节点计数器
+    markEdgesDirty();
+}
+
+void Graph::replaceWith(Graph&& other) {
+    // 版本号从不回退，否则依赖版本的缓存会把新图当作旧图
+    std::uint64_t nextMutations = std::max(mutations, other.mutations);
+    std::uint64_t nextEdgeMutations = std::max(edgeMutations, other.edgeMutations);
+    *this = std::move(other);
+    mutations = nextMutations;
+    edgeMutations = nextEdgeMutations;
+    markEdgesDirty();
 }
 
 void Graph::addEdge(int v1, int v2, double weight) {
     if (vexs.find(v1) == vexs.end() || vexs.find(v2) == vexs.end()) {
         return; // 节点不存在，直接返回
     }
+    if (v1 == v2) {
+        return; // 不保存自环，与批量提交的处理一致
+    }
 
-    // 始终使用较小的节点编号作为first，确保无向边的一致性
-    int minV = std::min(v1, v2);
-    int maxV = std::max(v1, v2);
-
-    edges.insert({minV, maxV});
-    edgeWeights[{minV, maxV}] = weight;
+    // 边存储内部按 (较小编号, 较大编号) 保存，确保无向边的一致性
+    if (edges.insertOrAssign(v1, v2, weight)) {
+        linkIncidence(v1, v2);
+    }
+    markEdgesDirty();
 }
 
 void Graph::updateEdgeWeight(int v1, int v2, double weight) {
-    int minV = std::min(v1, v2);
-    int maxV = std::max(v1, v2);
-
-    if (edges.find({minV, maxV}) != edges.end()) {
-        edgeWeights[{minV, maxV}] = weight;
+    if (edges.assign(v1, v2, weight)) {
+        markEdgesDirty();
     }
 }
 
 void Graph::removeEdge(int v1, int v2) {
-    int minV = std::min(v1, v2);
-    int maxV = std::max(v1, v2);
+    if (edges.erase(v1, v2)) {
+        unlinkIncidence(v1, v2);
+        markEdgesDirty();
+    }
+}
+
+void Graph::setVexPosition(int vexNum, double x, double y) {
+    auto it = vexs.find(vexNum);
+    if (it != vexs.end()) {
+        it->second.x = x;
+        it->second.y = y;
+        markDirty();
+    }
+}
+
+void Graph::beginBulk() {
+    bulkActive = true;
+}
+
+std::vector<int> Graph::insertVexes(const std::vector<Vex>& newVexs) {
+    std::vector<int> ids;
+    ids.reserve(newVexs.size());
+    nameIndex.reserve(nameIndex.size() + newVexs.size());
+    for (const auto& vex : newVexs) {
+        std::string key = trimName(vex.name);
+        if (nameIndex.find(key) != nameIndex.end()) {
+            ids.push_back(-1); // 名称重复
+            continue;
+        }
+
+        // 新编号总是最大的，带提示插入到末尾为均摊常数时间
+        int num = vexCounter++;
+        auto it = vexs.emplace_hint(vexs.end(), num, vex);
+        it->second.num = num;
+        nameIndex.emplace(std::move(key), num);
+        ids.push_back(num);
+    }
+    incidence.resize(vexCounter);
+    incidencePositions.resize(vexCounter);
+    markDirty();
+    return ids;
+}
 
-    edges.erase({minV, maxV});
-    edgeWeights.erase({minV, maxV});
+void Graph::addEdges(const std::vector<Edge>& newEdges) {
+    pendingEdges.insert(pendingEdges.end(), newEdges.begin(), newEdges.end());
+    if (!bulkActive) {
+        commit();
+    }
+}
+
+void Graph::commit() {
+    CAMPUS_PROFILE_SCOPE("graph.commit");
+    bulkActive = false;
+    if (pendingEdges.empty()) {
+        return;
+    }
+
+    // 先一次性预留哈希表容量，再按出现顺序写入；同一条边保留最后一次的权重，
+    // 与逐条 addEdge 的覆盖语义一致。自环与悬空端点被丢弃
+    edges.reserve(edges.size() + pendingEdges.size());
+    for (const auto& edge : pendingEdges) {
+        if (edge.vex1 == edge.vex2) continue;
+        if (vexs.find(edge.vex1) == vexs.end() || vexs.find(edge.vex2) == vexs.end()) continue;
+        if (edges.insertOrAssign(edge.vex1, edge.vex2, edge.weight)) {
+            linkIncidence(edge.vex1, edge.vex2);
+        }
+    }
+    pendingEdges.clear();
+    pendingEdges.shrink_to_fit();
+    markEdgesDirty();
 }
 
 Vex Graph::getVex(int vexNum) const {
@@ -86,17 +187,19 @@ Vex Graph::getVex(int vexNum) const {
 }
 
 int Graph::getVexIndex(const std::string& name) const {
-    std::string trimmedName = name;
-    trimmedName.erase(trimmedName.find_last_not_of(" \n\r\t") + 1); // 去除空格
-
-    for (const auto& pair : vexs) {
-        if (pair.second.name == trimmedName) {
-            return pair.first;
-        }
+    auto it = nameIndex.find(trimName(name));
+    if (it != nameIndex.end()) {
+        return it->second;
     }
     return -1;
 }
 
+std::string Graph::trimName(const std::string& name) {
+    std::string trimmedName = name;
+    trimmedName.erase(trimmedName.find_last_not_of(" \n\r\t") + 1); // 去除空格
+    return trimmedName;
+}
+
 std::vector<Vex> Graph::getAllVexs() const {
     std::vector<Vex> result;
     for (const auto& pair : vexs) {
@@ -107,23 +210,132 @@ std::vector<Vex> Graph::getAllVexs() const {
 
 std::vector<Edge> Graph::getAllEdges() const {
     std::vector<Edge> result;
-    for (const auto& edge : edges) {
-        result.push_back({edge.first, edge.second, edgeWeights.at(edge)});
+    result.reserve(edges.size());
+    for (const auto& record : edges.records()) {
+        result.push_back({record.v1, record.v2, record.weight});
     }
     return result;
 }
 
 std::map<int, std::vector<std::pair<int, double>>> Graph::getAdjacencyList() const {
+    CAMPUS_PROFILE_SCOPE("graph.getAdjacencyList");
     std::map<int, std::vector<std::pair<int, double>>> adjacencyList;
     for (const auto& vexPair : vexs) {
         adjacencyList[vexPair.first] = std::vector<std::pair<int, double>>();
     }
-    for (const auto& edge : edges) {
-        int v1 = edge.first;
-        int v2 = edge.second;
-        double weight = edgeWeights.at(edge);
-        adjacencyList[v1].push_back({v2, weight});
-        adjacencyList[v2].push_back({v1, weight}); // 无向图
+    for (const auto& record : edges.records()) {
+        adjacencyList[record.v1].push_back({record.v2, record.weight});
+        adjacencyList[record.v2].push_back({record.v1, record.weight}); // 无向图
     }
     return adjacencyList;
 }
+
+const std::vector<int>& Graph::getNeighbors(int vexNum) const {
+    static const std::vector<int> empty;
+    if (vexNum < 0 || vexNum >= static_cast<int>(incidence.size())) {
+        return empty;
+    }
+    return incidence[vexNum];
+}
+
+void Graph::linkIncidence(int v1, int v2) {
+    incidence[v1].push_back(v2);
+    incidencePositions[v1].push_back(static_cast<int>(incidence[v2].size()));
+    incidence[v2].push_back(v1);
+    incidencePositions[v2].push_back(static_cast<int>(incidence[v1].size()) - 1);
+}
+
+void Graph::eraseIncidenceAt(int vexNum, int pos) {
+    auto& list = incidence[vexNum];
+    auto& positions = incidencePositions[vexNum];
+    int last = static_cast<int>(list.size()) - 1;
+    if (pos != last) {
+        // 末项移入空位，并修正它在对端表中记录的位置
+        list[pos] = list[last];
+        positions[pos] = positions[last];
+        incidencePositions[list[pos]][positions[pos]] = pos;
+    }
+    list.pop_back();
+    positions.pop_back();
+}
+
+void Graph::unlinkIncidence(int v1, int v2) {
+    // 在较短的关联表中定位该边，对端的位置直接读取
+    if (incidence[v1].size() > incidence[v2].size()) {
+        std::swap(v1, v2);
+    }
+    const auto& list = incidence[v1];
+    int pos = static_cast<int>(std::find(list.begin(), list.end(), v2) - list.begin());
+    eraseIncidenceAt(v2, incidencePositions[v1][pos]);
+    eraseIncidenceAt(v1, pos);
+}
+
+std::shared_ptr<const CsrGraph> Graph::getCsrGraph() const {
+    if (csrDirty || !csr) {
+        rebuildCsr();
+    }
+    return csr;
+}
+
+void Graph::markDirty() {
+    ++mutations;
+    csrDirty = true;
+}
+
+void Graph::markEdgesDirty() {
+    ++edgeMutations;
+    markDirty();
+}
+
+std::uint64_t Graph::version() const {
+    return mutations;
+}
+
+std::uint64_t Graph::edgeVersion() const {
+    return edgeMutations;
+}
+
+void Graph::rebuildCsr() const {
+    CAMPUS_PROFILE_SCOPE("graph.rebuildCsr");
+    auto snapshot = std::make_shared<CsrGraph>();
+    int n = static_cast<int>(vexs.size());
+
+    // 分配稠密下标
+    snapshot->vexNums.reserve(n);
+    snapshot->xs.reserve(n);
+    snapshot->ys.reserve(n);
+    snapshot->denseIndex.assign(vexCounter, -1);
+    for (const auto& pair : vexs) {
+        snapshot->denseIndex[pair.first] = static_cast<int>(snapshot->vexNums.size());
+        snapshot->vexNums.push_back(pair.first);
+        snapshot->xs.push_back(pair.second.x);
+        snapshot->ys.push_back(pair.second.y);
+    }
+
+    // 统计度数并做前缀和得到偏移
+    snapshot->offsets.assign(n + 1, 0);
+    for (const auto& record : edges.records()) {
+        ++snapshot->offsets[snapshot->denseIndex[record.v1] + 1];
+        ++snapshot->offsets[snapshot->denseIndex[record.v2] + 1];
+    }
+    for (int i = 0; i < n; ++i) {
+        snapshot->offsets[i + 1] += snapshot->offsets[i];
+    }
+
+    // 填充邻居与权重（无向图，每条边写两次）
+    snapshot->neighbors.resize(snapshot->offsets[n]);
+    snapshot->weights.resize(snapshot->offsets[n]);
+    std::vector<int> cursor(snapshot->offsets.begin(), snapshot->offsets.end() - 1);
+    for (const auto& record : edges.records()) {
+        int u = snapshot->denseIndex[record.v1];
+        int v = snapshot->denseIndex[record.v2];
+        double weight = record.weight;
+        snapshot->neighbors[cursor[u]] = v;
+        snapshot->weights[cursor[u]++] = weight;
+        snapshot->neighbors[cursor[v]] = u;
+        snapshot->weights[cursor[v]++] = weight;
+    }
+
+    csr = std::move(snapshot);
+    csrDirty = false;
+}
@@ -4,14 +4,19 @@
 #include <string>
 #include <vector>
 #include <map>
-#include <set>
+#include <unordered_map>
 #include <utility>
+#include <memory>
+#include <cstdint>
+#include "EdgeStore.h"
 
 struct Vex {
     int num;                     // 节点编号
     std::string name;            // 节点名称
     std::string introduction;    // 节点介绍
     std::string ticketInfo;      // 门票信息
+    double x = 0.0;              // 场景中的横坐标
+    double y = 0.0;              // 场景中的纵坐标
 };
 
 struct Edge {
@@ -20,17 +25,46 @@ struct Edge {
     double weight;               // 边的权重
 };
 
+// 压缩稀疏行（CSR）形式的只读邻接快照
+// 节点按编号升序映射到稠密下标 [0, size())，邻居与权重按下标紧凑存放
+struct CsrGraph {
+    std::vector<int> vexNums;    // 稠密下标 -> 节点编号
+    std::vector<int> denseIndex; // 节点编号 -> 稠密下标（已删除的编号为 -1）
+    std::vector<int> offsets;    // 下标 i 的邻居位于 [offsets[i], offsets[i + 1])
+    std::vector<int> neighbors;  // 邻居的稠密下标
+    std::vector<double> weights; // 与 neighbors 一一对应的边权重
+    std::vector<double> xs;      // 稠密下标 -> 横坐标
+    std::vector<double> ys;      // 稠密下标 -> 纵坐标
+
+    int size() const { return static_cast<int>(vexNums.size()); }
+    int indexOf(int vexNum) const {
+        if (vexNum < 0 || vexNum >= static_cast<int>(denseIndex.size())) return -1;
+        return denseIndex[vexNum];
+    }
+    int vexNum(int index) const { return vexNums[index]; }
+    int degree(int index) const { return offsets[index + 1] - offsets[index]; }
+};
+
 class Graph {
 public:
     Graph();                                     // 构造函数
     int insertVex(const Vex& vex);               // 插入一个节点，返回节点编号
-    bool removeVex(int vexNum);                  // 删除一个节点
+    bool removeVex(int vexNum, std::vector<Edge>* removedEdges = nullptr); // 删除一个节点，可选返回被一并删除的边
     void clearEdges();                           // 清空所有边
     void clearGraph();                           // **清空整个图**
+    void replaceWith(Graph&& other);             // 以另一个图的内容替换本图（版本号继续递增）
     void addEdge(int v1, int v2, double weight); // 添加一条边
     void updateEdgeWeight(int v1, int v2, double weight); // 更新边的权重
     void removeEdge(int v1, int v2);             // 删除一条边
+    void setVexPosition(int vexNum, double x, double y); // 更新节点坐标
+
+    // 批量构建：beginBulk 之后的 addEdges 只追加到缓冲区，commit 时一次性写入（重复的边保留最后的权重，丢弃自环与悬空端点）
+    void beginBulk();                            // 开始批量修改
+    std::vector<int> insertVexes(const std::vector<Vex>& newVexs); // 批量插入节点，返回各节点编号（重名为 -1）
+    void addEdges(const std::vector<Edge>& newEdges); // 批量添加边（不在批量模式时立即提交）
+    void commit();                               // 结束批量修改并提交缓冲的边
     Vex getVex(int vexNum) const;                // 根据编号获取节点
+    const std::vector<int>& getNeighbors(int vexNum) const; // 获取节点的相邻节点编号
     int getVexIndex(const std::string& name) const; // 获取节点索引
     std::vector<Vex> getAllVexs() const;         // 获取所有节点
     std::vector<Edge> getAllEdges() const;       // 获取所有边
@@ -38,11 +72,36 @@ public:
     // 获取邻接表
     std::map<int, std::vector<std::pair<int, double>>> getAdjacencyList() const;
 
+    // 获取CSR邻接快照（图被修改后才会惰性重建，快照本身不可变）
+    std::shared_ptr<const CsrGraph> getCsrGraph() const;
+
+    // 版本：任何修改（含节点坐标）都会递增，从不回退
+    std::uint64_t version() const;
+    // 边版本：边的增删或权重变化时递增（清空图也递增，从不回退）
+    std::uint64_t edgeVersion() const;
+
 private:
+    static std::string trimName(const std::string& name); // 去除名称尾部空白
+    void markDirty();                            // 标记邻接快照失效
+    void markEdgesDirty();                       // 边集合或权重变化：递增边版本并标记快照失效
+    void rebuildCsr() const;                     // 重建邻接快照
+    void linkIncidence(int v1, int v2);          // 在关联表中登记一条边
+    void unlinkIncidence(int v1, int v2);        // 从关联表中移除一条边（O(两端中较小的度数)）
+    void eraseIncidenceAt(int vexNum, int pos);  // 交换删除关联表中的一项（O(1)）
+
     int vexCounter;                              // 节点计数器
     std::map<int, Vex> vexs;                     // 节点映射
-    std::set<std::pair<int, int>> edges;         // 边集合
-    std::map<std::pair<int, int>, double> edgeWeights; // 边的权重映射
+    std::unordered_map<std::string, int> nameIndex; // 名称 -> 节点编号
+    EdgeStore edges;                             // 边集合（权重内联存放）
+    std::vector<std::vector<int>> incidence;     // 节点编号 -> 相邻节点编号（删除节点只需 O(度数)）
+    std::vector<std::vector<int>> incidencePositions; // 与 incidence 对应：该项在对端关联表中的位置
+    std::vector<Edge> pendingEdges;              // 批量模式下缓冲的边
+    bool bulkActive;                             // 是否处于批量模式
+    std::uint64_t mutations;                     // 版本计数
+    std::uint64_t edgeMutations;                 // 边版本计数
+
+    mutable std::shared_ptr<const CsrGraph> csr; // 邻接快照缓存
+    mutable bool csrDirty;                       // 快照是否需要重建
 };
 
 #endif // GRAPH_H
@@ -0,0 +1,214 @@
+#include "GraphIO.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <random>
+
+namespace {
+
+// 在缓冲区上顺序读取行的游标
+class LineReader {
+public:
+    explicit LineReader(std::string_view text) : text(text), pos(0) {
+        // 跳过 UTF-8 BOM
+        if (this->text.substr(0, 3) == "\xEF\xBB\xBF") {
+            pos = 3;
+        }
+    }
+
+    // 读取下一行（不含换行符），已到末尾时返回 false
+    bool next(std::string_view& line) {
+        if (pos >= text.size()) {
+            return false;
+        }
+        size_t end = text.find('\n', pos);
+        if (end == std::string_view::npos) {
+            end = text.size();
+        }
+        line = text.substr(pos, end - pos);
+        pos = end + 1;
+        return true;
+    }
+
+    // 剩余的最多行数（每行至少占一个字节）
+    size_t remainingLines() const {
+        return pos >= text.size() ? 0 : text.size() - pos;
+    }
+
+private:
+    std::string_view text;
+    size_t pos;
+};
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+std::string_view trim(std::string_view s) {
+    size_t begin = 0;
+    while (begin < s.size() && isSpace(s[begin])) ++begin;
+    size_t end = s.size();
+    while (end > begin && isSpace(s[end - 1])) --end;
+    return s.substr(begin, end - begin);
+}
+
+bool parseInt(std::string_view s, int& value) {
+    s = trim(s);
+    if (s.empty()) {
+        return false;
+    }
+    auto result = std::from_chars(s.data(), s.data() + s.size(), value);
+    return result.ec == std::errc() && result.ptr == s.data() + s.size();
+}
+
+// 取出下一个以空白分隔的记号
+std::string_view nextToken(std::string_view& s) {
+    size_t begin = 0;
+    while (begin < s.size() && isSpace(s[begin])) ++begin;
+    size_t end = begin;
+    while (end < s.size() && !isSpace(s[end])) ++end;
+    std::string_view token = s.substr(begin, end - begin);
+    s.remove_prefix(end);
+    return token;
+}
+
+} // namespace
+
+bool GraphIO::parseText(std::string_view text, ParsedGraph& out, std::string& error) {
+    CAMPUS_PROFILE_SCOPE("io.parseText");
+    LineReader reader(text);
+    std::string_view line;
+
+    int nodeCount = 0;
+    if (!reader.next(line) || !parseInt(line, nodeCount) || nodeCount <= 0) {
+        error = "文件格式错误：节点数量无效！";
+        return false;
+    }
+
+    // 读取节点信息
+    out.vexs.clear();
+    // 数量来自文件头，按剩余内容最多能容纳的行数限制预留，避免伪造的数量耗尽内存
+    out.vexs.reserve(std::min(static_cast<size_t>(nodeCount), reader.remainingLines() / 2 + 1));
+    for (int i = 0; i < nodeCount; ++i) {
+        std::string_view name;
+        std::string_view info;
+        if (!reader.next(name) || !reader.next(info)) {
+            error = "文件格式错误：节点信息不足！";
+            return false;
+        }
+
+        Vex vex;
+        vex.name = std::string(trim(name));
+        vex.introduction = std::string(trim(info));
+        vex.ticketInfo = "暂无门票信息";
+        out.vexs.push_back(std::move(vex));
+    }
+
+    int edgeCount = 0;
+    if (!reader.next(line) || !parseInt(line, edgeCount) || edgeCount < 0) {
+        error = "文件格式错误：边数量无效！";
+        return false;
+    }
+
+    // 读取边信息
+    out.edges.clear();
+    out.edges.reserve(std::min(static_cast<size_t>(edgeCount), reader.remainingLines()));
+    for (int i = 0; i < edgeCount; ++i) {
+        if (!reader.next(line)) {
+            error = "文件格式错误：边信息不足！";
+            return false;
+        }
+        std::string_view startName = nextToken(line);
+        std::string_view endName = nextToken(line);
+        if (startName.empty() || endName.empty()) {
+            error = "文件格式错误：边格式不正确！";
+            return false;
+        }
+        out.edges.push_back({startName, endName});
+    }
+
+    return true;
+}
+
+void GraphIO::buildGraph(const ParsedGraph& parsed, unsigned int seed, Graph& graph) {
+    CAMPUS_PROFILE_SCOPE("io.buildGraph");
+    std::vector<Vex> vexs(parsed.vexs);
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> distributionX(0.0, kMapWidth);
+    std::uniform_real_distribution<double> distributionY(0.0, kMapHeight);
+    for (Vex& vex : vexs) {
+        vex.x = distributionX(generator);
+        vex.y = distributionY(generator);
+    }
+
+    graph.beginBulk();
+    std::vector<int> ids = graph.insertVexes(vexs);
+
+    // 按编号记录坐标供计算权重（重名的节点未插入，编号为 -1）
+    int maxId = -1;
+    for (int id : ids) {
+        maxId = std::max(maxId, id);
+    }
+    std::vector<std::pair<double, double>> positions(maxId + 1);
+    for (size_t i = 0; i < ids.size(); ++i) {
+        if (ids[i] != -1) {
+            positions[ids[i]] = {vexs[i].x, vexs[i].y};
+        }
+    }
+
+    std::vector<Edge> edges;
+    edges.reserve(parsed.edges.size());
+    std::string startName;
+    std::string endName;
+    for (const auto& edge : parsed.edges) {
+        startName.assign(edge.first);
+        endName.assign(edge.second);
+        int startId = graph.getVexIndex(startName);
+        int endId = graph.getVexIndex(endName);
+        if (startId == -1 || endId == -1 || startId == endId) continue;
+
+        double weight = std::hypot(positions[startId].first - positions[endId].first,
+                                   positions[startId].second - positions[endId].second);
+        edges.push_back({startId, endId, weight});
+    }
+    graph.addEdges(edges);
+    graph.commit();
+}
+
+std::string GraphIO::writeText(const Graph& graph) {
+    CAMPUS_PROFILE_SCOPE("io.writeText");
+    std::vector<Vex> allVexs = graph.getAllVexs();
+    std::vector<Edge> allEdges = graph.getAllEdges();
+
+    // 节点编号 -> 名称，写边时不必逐条复制节点
+    std::vector<const std::string*> names;
+    for (const auto& vex : allVexs) {
+        if (vex.num >= static_cast<int>(names.size())) {
+            names.resize(vex.num + 1, nullptr);
+        }
+        names[vex.num] = &vex.name;
+    }
+
+    // 写入节点信息
+    std::string out;
+    out += std::to_string(allVexs.size());
+    out += '\n';
+    for (const auto& vex : allVexs) {
+        out += vex.name;
+        out += '\n';
+        out += vex.introduction;
+        out += '\n';
+    }
+
+    // 写入边信息
+    out += std::to_string(allEdges.size());
+    out += '\n';
+    for (const auto& edge : allEdges) {
+        out += *names[edge.vex1];
+        out += ' ';
+        out += *names[edge.vex2];
+        out += '\n';
+    }
+    return out;
+}
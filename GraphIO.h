@@ -0,0 +1,37 @@
+#ifndef GRAPHIO_H
+#define GRAPHIO_H
+
+#include "Graph.h"
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// 文本格式解析的结果
+// 边的两端名称直接指向输入缓冲区，调用方需保证缓冲区在使用期间有效
+struct ParsedGraph {
+    std::vector<Vex> vexs;                       // 节点（只填写名称和介绍）
+    std::vector<std::pair<std::string_view, std::string_view>> edges; // 边的两端名称
+};
+
+namespace GraphIO {
+
+// 文本格式不含坐标，导入时节点随机放置在该范围内（与界面的场景范围一致）
+const double kMapWidth = 800.0;
+const double kMapHeight = 600.0;
+
+// 解析导出的文本格式：
+//   节点数 / 每个节点两行（名称、介绍）/ 边数 / 每条边一行（起点名 终点名）
+// 整个文件作为一个 UTF-8 缓冲区按行切分，不逐行分配字符串。失败时返回 false 并写入 error
+bool parseText(std::string_view text, ParsedGraph& out, std::string& error);
+
+// 由解析结果批量建图：节点按 seed 随机放置在 kMapWidth x kMapHeight 内，边权为两端直线距离；
+// 端点名称不存在的边和自环被忽略。graph 应为空图。界面导入、campus-query 与基准测试共用这一规则
+void buildGraph(const ParsedGraph& parsed, unsigned int seed, Graph& graph);
+
+// 按同一文本格式写出整个图（与 parseText 互逆，不含坐标与权重）
+std::string writeText(const Graph& graph);
+
+} // namespace GraphIO
+
+#endif // GRAPHIO_H
@@ -0,0 +1,274 @@
+#include "GraphSnapshot.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+std::uint64_t alignUp(std::uint64_t value) {
+    return (value + 7) & ~static_cast<std::uint64_t>(7);
+}
+
+// 各段相对文件起始的偏移
+struct Layout {
+    std::uint64_t vertices;
+    std::uint64_t offsets;
+    std::uint64_t neighbors;
+    std::uint64_t weights;
+    std::uint64_t strings;
+    std::uint64_t total;
+};
+
+// 带溢出检查的加法与乘法，溢出时返回 false
+bool addChecked(std::uint64_t a, std::uint64_t b, std::uint64_t& out) {
+    if (a > UINT64_MAX - b) return false;
+    out = a + b;
+    return true;
+}
+
+bool mulChecked(std::uint64_t a, std::uint64_t b, std::uint64_t& out) {
+    if (a != 0 && b > UINT64_MAX / a) return false;
+    out = a * b;
+    return true;
+}
+
+bool alignChecked(std::uint64_t value, std::uint64_t& out) {
+    if (!addChecked(value, 7, out)) return false;
+    out &= ~static_cast<std::uint64_t>(7);
+    return true;
+}
+
+// 计算各段偏移；尺寸来自文件头（不可信），任一步溢出时返回 false
+bool computeLayout(std::uint64_t n, std::uint64_t m, std::uint64_t stringBytes, Layout& layout) {
+    std::uint64_t bytes = 0;
+    std::uint64_t end = 0;
+    layout.vertices = alignUp(sizeof(GraphSnapshot::Header));
+    return mulChecked(n, sizeof(GraphSnapshot::VertexRecord), bytes) &&
+           addChecked(layout.vertices, bytes, end) && alignChecked(end, layout.offsets) &&
+           mulChecked(n + 1, sizeof(std::uint32_t), bytes) &&
+           addChecked(layout.offsets, bytes, end) && alignChecked(end, layout.neighbors) &&
+           mulChecked(m, sizeof(std::uint32_t), bytes) &&
+           addChecked(layout.neighbors, bytes, end) && alignChecked(end, layout.weights) &&
+           mulChecked(m, sizeof(double), bytes) &&
+           addChecked(layout.weights, bytes, end) && alignChecked(end, layout.strings) &&
+           addChecked(layout.strings, stringBytes, layout.total);
+}
+
+} // namespace
+
+bool GraphSnapshot::View::open(std::string_view data, std::string& error) {
+    if (data.size() < sizeof(Header)) {
+        error = "快照文件过小！";
+        return false;
+    }
+
+    // 映射区总是按页对齐；其他来源的缓冲区未对齐时复制一份
+    const char* base = data.data();
+    if (reinterpret_cast<std::uintptr_t>(base) % alignof(std::uint64_t) != 0) {
+        alignedCopy.assign((data.size() + 7) / 8, 0);
+        std::memcpy(alignedCopy.data(), data.data(), data.size());
+        base = reinterpret_cast<const char*>(alignedCopy.data());
+    }
+
+    header = reinterpret_cast<const Header*>(base);
+    if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0) {
+        error = "不是有效的图快照文件！";
+        return false;
+    }
+    if (header->byteOrderMark != kByteOrderMark) {
+        error = "快照文件的字节序与本机不一致！";
+        return false;
+    }
+    if (header->version != kVersion) {
+        error = "不支持的快照版本：" + std::to_string(header->version);
+        return false;
+    }
+
+    // 先用文件大小约束各个计数，再以带溢出检查的运算计算布局
+    Layout layout;
+    if (header->vertexCount > data.size() / sizeof(VertexRecord) ||
+        header->adjacencyCount > data.size() / (sizeof(std::uint32_t) + sizeof(double)) ||
+        header->stringTableSize > data.size() ||
+        !computeLayout(header->vertexCount, header->adjacencyCount, header->stringTableSize, layout) ||
+        layout.total > data.size()) {
+        error = "快照文件已截断！";
+        return false;
+    }
+
+    vertices = reinterpret_cast<const VertexRecord*>(base + layout.vertices);
+    offsetArray = reinterpret_cast<const std::uint32_t*>(base + layout.offsets);
+    neighborArray = reinterpret_cast<const std::uint32_t*>(base + layout.neighbors);
+    weightArray = reinterpret_cast<const double*>(base + layout.weights);
+    strings = base + layout.strings;
+
+    // 校验索引范围，避免损坏的文件导致越界访问
+    std::uint32_t n = header->vertexCount;
+    if (offsetArray[0] != 0 || offsetArray[n] != header->adjacencyCount) {
+        error = "快照文件的邻接偏移无效！";
+        return false;
+    }
+    for (std::uint32_t i = 0; i < n; ++i) {
+        if (offsetArray[i] > offsetArray[i + 1]) {
+            error = "快照文件的邻接偏移无效！";
+            return false;
+        }
+        const VertexRecord& v = vertices[i];
+        std::uint64_t limit = header->stringTableSize;
+        if (std::uint64_t(v.nameOffset) + v.nameLength > limit ||
+            std::uint64_t(v.introOffset) + v.introLength > limit ||
+            std::uint64_t(v.ticketOffset) + v.ticketLength > limit) {
+            error = "快照文件的字符串表无效！";
+            return false;
+        }
+    }
+    for (std::uint64_t e = 0; e < header->adjacencyCount; ++e) {
+        if (neighborArray[e] >= n) {
+            error = "快照文件的邻居下标无效！";
+            return false;
+        }
+        if (!std::isfinite(weightArray[e]) || weightArray[e] < 0.0) {
+            error = "快照文件的边权重无效！";
+            return false;
+        }
+    }
+    return true;
+}
+
+std::uint32_t GraphSnapshot::View::vertexCount() const {
+    return header->vertexCount;
+}
+
+std::uint64_t GraphSnapshot::View::adjacencyCount() const {
+    return header->adjacencyCount;
+}
+
+const GraphSnapshot::VertexRecord& GraphSnapshot::View::vertex(std::uint32_t index) const {
+    return vertices[index];
+}
+
+std::string_view GraphSnapshot::View::string(std::uint32_t offset, std::uint32_t length) const {
+    return std::string_view(strings + offset, length);
+}
+
+const std::uint32_t* GraphSnapshot::View::offsets() const {
+    return offsetArray;
+}
+
+const std::uint32_t* GraphSnapshot::View::neighbors() const {
+    return neighborArray;
+}
+
+const double* GraphSnapshot::View::weights() const {
+    return weightArray;
+}
+
+bool GraphSnapshot::serialize(const Graph& graph, std::string& out, std::string& error) {
+    CAMPUS_PROFILE_SCOPE("io.snapshotSerialize");
+    auto csr = graph.getCsrGraph();
+    std::uint64_t n = csr->size();
+    std::uint64_t m = csr->neighbors.size();
+
+    // 节点数、CSR 偏移与邻居下标都以 32 位保存，超出范围时拒绝而不是截断
+    const std::uint64_t kMax32 = std::numeric_limits<std::uint32_t>::max();
+    if (n > kMax32 || m > kMax32) {
+        error = "图的规模超出快照格式的范围！";
+        return false;
+    }
+
+    // 先生成字符串表和节点记录
+    std::string stringTable;
+    std::vector<VertexRecord> records(n);
+    auto appendString = [&stringTable](const std::string& s, std::uint32_t& offset, std::uint32_t& length) {
+        offset = static_cast<std::uint32_t>(stringTable.size());
+        length = static_cast<std::uint32_t>(s.size());
+        stringTable += s;
+    };
+    for (std::uint64_t i = 0; i < n; ++i) {
+        Vex vex = graph.getVex(csr->vexNum(static_cast<int>(i)));
+        VertexRecord& record = records[i];
+        appendString(vex.name, record.nameOffset, record.nameLength);
+        appendString(vex.introduction, record.introOffset, record.introLength);
+        appendString(vex.ticketInfo, record.ticketOffset, record.ticketLength);
+        record.x = csr->xs[i];
+        record.y = csr->ys[i];
+        // 字符串表的偏移与长度同样是 32 位
+        if (stringTable.size() > kMax32) {
+            error = "节点文本总长度超出快照格式的范围！";
+            return false;
+        }
+    }
+
+    Layout layout;
+    if (!computeLayout(n, m, stringTable.size(), layout)) {
+        error = "图的规模超出快照格式的范围！";
+        return false;
+    }
+    out.assign(layout.total, '\0');
+    char* base = &out[0];
+
+    Header header;
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.byteOrderMark = kByteOrderMark;
+    header.vertexCount = static_cast<std::uint32_t>(n);
+    header.adjacencyCount = m;
+    header.stringTableSize = stringTable.size();
+    std::memcpy(base, &header, sizeof(header));
+
+    std::memcpy(base + layout.vertices, records.data(), n * sizeof(VertexRecord));
+    std::vector<std::uint32_t> offsets(csr->offsets.begin(), csr->offsets.end());
+    std::memcpy(base + layout.offsets, offsets.data(), offsets.size() * sizeof(std::uint32_t));
+    std::vector<std::uint32_t> neighbors(csr->neighbors.begin(), csr->neighbors.end());
+    std::memcpy(base + layout.neighbors, neighbors.data(), m * sizeof(std::uint32_t));
+    std::memcpy(base + layout.weights, csr->weights.data(), m * sizeof(double));
+    std::memcpy(base + layout.strings, stringTable.data(), stringTable.size());
+    return true;
+}
+
+bool GraphSnapshot::load(std::string_view data, Graph& graph, std::string& error) {
+    CAMPUS_PROFILE_SCOPE("io.snapshotLoad");
+    View view;
+    if (!view.open(data, error)) {
+        return false;
+    }
+
+    std::uint32_t n = view.vertexCount();
+    std::vector<Vex> newVexs(n);
+    for (std::uint32_t i = 0; i < n; ++i) {
+        const VertexRecord& record = view.vertex(i);
+        Vex& vex = newVexs[i];
+        vex.name = std::string(view.string(record.nameOffset, record.nameLength));
+        vex.introduction = std::string(view.string(record.introOffset, record.introLength));
+        vex.ticketInfo = std::string(view.string(record.ticketOffset, record.ticketLength));
+        vex.x = record.x;
+        vex.y = record.y;
+    }
+
+    graph.beginBulk();
+    std::vector<int> ids = graph.insertVexes(newVexs);
+    if (std::find(ids.begin(), ids.end(), -1) != ids.end()) {
+        graph.commit();
+        error = "快照文件中存在重复的节点名称！";
+        return false;
+    }
+
+    // 每条无向边在 CSR 中出现两次，只取 u < v 的一半
+    const std::uint32_t* offsets = view.offsets();
+    const std::uint32_t* neighbors = view.neighbors();
+    const double* weights = view.weights();
+    std::vector<Edge> newEdges;
+    newEdges.reserve(view.adjacencyCount() / 2);
+    for (std::uint32_t u = 0; u < n; ++u) {
+        for (std::uint32_t e = offsets[u]; e < offsets[u + 1]; ++e) {
+            std::uint32_t v = neighbors[e];
+            if (u < v) {
+                newEdges.push_back({ids[u], ids[v], weights[e]});
+            }
+        }
+    }
+    graph.addEdges(newEdges);
+    graph.commit();
+    return true;
+}
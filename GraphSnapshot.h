@@ -0,0 +1,69 @@
+#ifndef GRAPHSNAPSHOT_H
+#define GRAPHSNAPSHOT_H
+
+#include "Graph.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 二进制图快照（.ctg）
+// 布局（小端，各段按 8 字节对齐）：
+//   文件头 | 节点记录[n] | CSR 偏移[n+1] | 邻居[m] | 权重[m] | 字符串表
+// 节点记录保存名称/介绍/门票在字符串表中的位置以及坐标，边以 CSR 形式保存，
+// 因此加载时无需解析文本，也无需按坐标重新计算权重
+namespace GraphSnapshot {
+
+const char kMagic[4] = {'C', 'T', 'G', 'S'};
+const std::uint32_t kVersion = 1;
+const std::uint32_t kByteOrderMark = 0x01020304;
+
+struct Header {
+    char magic[4];                   // 固定为 "CTGS"
+    std::uint32_t version;           // 格式版本
+    std::uint32_t byteOrderMark;     // 用于检测字节序
+    std::uint32_t vertexCount;       // 节点数 n
+    std::uint64_t adjacencyCount;    // 邻接项数 m（无向边数的两倍）
+    std::uint64_t stringTableSize;   // 字符串表字节数
+};
+
+struct VertexRecord {
+    std::uint32_t nameOffset;
+    std::uint32_t nameLength;
+    std::uint32_t introOffset;
+    std::uint32_t introLength;
+    std::uint32_t ticketOffset;
+    std::uint32_t ticketLength;
+    double x;
+    double y;
+};
+
+// 只读视图：校验缓冲区后直接指向其中的各段，不做复制
+class View {
+public:
+    bool open(std::string_view data, std::string& error); // 校验并绑定缓冲区
+
+    std::uint32_t vertexCount() const;
+    std::uint64_t adjacencyCount() const;
+    const VertexRecord& vertex(std::uint32_t index) const;
+    std::string_view string(std::uint32_t offset, std::uint32_t length) const;
+    const std::uint32_t* offsets() const;     // CSR 偏移，长度 n + 1
+    const std::uint32_t* neighbors() const;   // 邻居下标，长度 m
+    const double* weights() const;            // 权重，长度 m
+
+private:
+    const Header* header = nullptr;
+    const VertexRecord* vertices = nullptr;
+    const std::uint32_t* offsetArray = nullptr;
+    const std::uint32_t* neighborArray = nullptr;
+    const double* weightArray = nullptr;
+    const char* strings = nullptr;
+    std::vector<std::uint64_t> alignedCopy;   // 缓冲区未按 8 字节对齐时的副本
+};
+
+bool serialize(const Graph& graph, std::string& out, std::string& error); // 把图序列化为快照字节（超出格式的 32 位范围时失败）
+bool load(std::string_view data, Graph& graph, std::string& error); // 从快照字节重建图（应传入空图，失败时图可能只加载了一部分）
+
+} // namespace GraphSnapshot
+
+#endif // GRAPHSNAPSHOT_H
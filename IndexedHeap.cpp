@@ -0,0 +1,110 @@
+#include "IndexedHeap.h"
+
+IndexedHeap::IndexedHeap(int capacity) {
+    reset(capacity);
+}
+
+void IndexedHeap::reset(int capacity) {
+    heap.clear();
+    keys.clear();
+    position.assign(capacity, -1);
+}
+
+void IndexedHeap::clear() {
+    for (int id : heap) {
+        position[id] = -1;
+    }
+    heap.clear();
+    keys.clear();
+}
+
+bool IndexedHeap::empty() const {
+    return heap.empty();
+}
+
+int IndexedHeap::size() const {
+    return static_cast<int>(heap.size());
+}
+
+bool IndexedHeap::contains(int id) const {
+    return position[id] != -1;
+}
+
+double IndexedHeap::keyOf(int id) const {
+    return keys[position[id]];
+}
+
+void IndexedHeap::push(int id, double key) {
+    if (contains(id)) {
+        decreaseKey(id, key);
+        return;
+    }
+    heap.push_back(id);
+    keys.push_back(key);
+    position[id] = static_cast<int>(heap.size()) - 1;
+    siftUp(position[id]);
+}
+
+void IndexedHeap::decreaseKey(int id, double key) {
+    int pos = position[id];
+    if (key < keys[pos]) {
+        keys[pos] = key;
+        siftUp(pos);
+    }
+}
+
+int IndexedHeap::top() const {
+    return heap.front();
+}
+
+double IndexedHeap::topKey() const {
+    return keys.front();
+}
+
+int IndexedHeap::pop() {
+    int id = heap.front();
+    position[id] = -1;
+
+    int lastId = heap.back();
+    double lastKey = keys.back();
+    heap.pop_back();
+    keys.pop_back();
+    if (!heap.empty()) {
+        place(0, lastId, lastKey);
+        siftDown(0);
+    }
+    return id;
+}
+
+void IndexedHeap::siftUp(int pos) {
+    int id = heap[pos];
+    double key = keys[pos];
+    while (pos > 0) {
+        int parent = (pos - 1) / 2;
+        if (keys[parent] <= key) break;
+        place(pos, heap[parent], keys[parent]);
+        pos = parent;
+    }
+    place(pos, id, key);
+}
+
+void IndexedHeap::siftDown(int pos) {
+    int n = static_cast<int>(heap.size());
+    int id = heap[pos];
+    double key = keys[pos];
+    while (true) {
+        int child = 2 * pos + 1;
+        if (child >= n) break;
+        if (child + 1 < n && keys[child + 1] < keys[child]) ++child;
+        if (key <= keys[child]) break;
+        place(pos, heap[child], keys[child]);
+        pos = child;
+    }
+    place(pos, id, key);
+}
+
+void IndexedHeap::place(int pos, int id, double key) {
+    heap[pos] = id;
+    keys[pos] = key;
+    position[id] = pos;
+}
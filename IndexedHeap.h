@@ -0,0 +1,33 @@
+#ifndef INDEXEDHEAP_H
+#define INDEXEDHEAP_H
+
+#include <vector>
+
+// 支持降键操作的索引二叉最小堆
+// 元素为 [0, capacity) 内的整数下标，每个下标至多在堆中出现一次
+class IndexedHeap {
+public:
+    explicit IndexedHeap(int capacity = 0);  // 构造函数
+    void reset(int capacity);                // 重新设定容量并清空
+    void clear();                            // 清空堆（代价与堆内元素数成正比）
+    bool empty() const;                      // 堆是否为空
+    int size() const;                        // 堆内元素个数
+    bool contains(int id) const;             // 下标是否在堆中
+    double keyOf(int id) const;              // 获取堆内元素的键值
+    void push(int id, double key);           // 插入元素，已存在时等价于 decreaseKey
+    void decreaseKey(int id, double key);    // 降低元素的键值
+    int top() const;                         // 获取键值最小的元素
+    double topKey() const;                   // 获取最小键值
+    int pop();                               // 弹出键值最小的元素
+
+private:
+    void siftUp(int pos);
+    void siftDown(int pos);
+    void place(int pos, int id, double key);
+
+    std::vector<int> heap;                   // 堆中存放的下标
+    std::vector<double> keys;                // 与 heap 对应的键值
+    std::vector<int> position;               // 下标 -> 在堆中的位置（不在堆中为 -1）
+};
+
+#endif // INDEXEDHEAP_H
@@ -0,0 +1,192 @@
+#include "KShortestPaths.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <limits>
+#include <set>
+#include <utility>
+
+namespace {
+const double kInfinity = std::numeric_limits<double>::infinity();
+}
+
+KShortestPaths::KShortestPaths(std::shared_ptr<const CsrGraph> graph)
+    : graph(graph), cancelFlag(nullptr), engine(graph), spurSearches(0), treeReuses(0) {
+    bannedNodes.assign(this->graph->size(), 0);
+    bannedArcs.assign(this->graph->neighbors.size(), 0);
+}
+
+void KShortestPaths::setCancelFlag(const std::atomic_bool* flag) {
+    cancelFlag = flag;
+    engine.setCancelFlag(flag);
+}
+
+bool KShortestPaths::isCancelled() const {
+    return cancelFlag && cancelFlag->load(std::memory_order_relaxed);
+}
+
+int KShortestPaths::spurSearchCount() const {
+    return spurSearches;
+}
+
+int KShortestPaths::treeReuseCount() const {
+    return treeReuses;
+}
+
+int KShortestPaths::arcIndex(int from, int to) const {
+    for (int e = graph->offsets[from]; e < graph->offsets[from + 1]; ++e) {
+        if (graph->neighbors[e] == to) {
+            return e;
+        }
+    }
+    return -1;
+}
+
+void KShortestPaths::setArcBanned(int from, int to, char banned) {
+    bannedArcs[arcIndex(from, to)] = banned;
+    bannedArcs[arcIndex(to, from)] = banned;
+}
+
+bool KShortestPaths::treeDetour(int spur, std::vector<int>& path, double& cost) const {
+    // 任何偏离路径的长度都不小于 min(第一步边权 + 该邻居到终点的距离)
+    int best = -1;
+    cost = kInfinity;
+    for (int e = graph->offsets[spur]; e < graph->offsets[spur + 1]; ++e) {
+        int neighbor = graph->neighbors[e];
+        if (bannedArcs[e] || bannedNodes[neighbor]) continue;
+        double candidate = graph->weights[e] + toTarget[neighbor];
+        if (candidate < cost) {
+            cost = candidate;
+            best = neighbor;
+        }
+    }
+    if (best == -1) {
+        return false;
+    }
+
+    // 该邻居沿树到终点的路径未被禁用且不回到偏离点时，下界可以取到
+    for (int at = best; nextHop[at] != -1; at = nextHop[at]) {
+        int next = nextHop[at];
+        if (next == spur || bannedNodes[next] || bannedArcs[arcIndex(at, next)]) {
+            return false;
+        }
+    }
+    path.assign(1, spur);
+    for (int at = best; at != -1; at = nextHop[at]) {
+        path.push_back(at);
+    }
+    return true;
+}
+
+std::vector<RouteResult> KShortestPaths::find(int src, int dst, int k) {
+    CAMPUS_PROFILE_SCOPE("yen.find");
+    spurSearches = 0;
+    treeReuses = 0;
+    std::vector<RouteResult> result;
+    int source = graph->indexOf(src);
+    int target = graph->indexOf(dst);
+    if (k <= 0 || source == -1 || target == -1) {
+        return result;
+    }
+    if (!engine.shortestPathTree(dst, toTarget, nextHop) || toTarget[source] == kInfinity) {
+        return result;
+    }
+
+    // 已确定的路径（稠密下标）及其长度；候选路径按长度排序，seen 用于去重
+    std::vector<std::vector<int>> accepted;
+    std::vector<double> acceptedCosts;
+    std::set<std::pair<double, std::vector<int>>> candidates;
+    std::set<std::vector<int>> seen;
+
+    std::vector<int> first;
+    for (int at = source; at != -1; at = nextHop[at]) {
+        first.push_back(at);
+    }
+    candidates.emplace(toTarget[source], first);
+    seen.insert(first);
+
+    SearchConstraints constraints;
+    constraints.bannedNodes = &bannedNodes;
+    constraints.bannedArcs = &bannedArcs;
+    constraints.potential = &toTarget;
+
+    while (static_cast<int>(accepted.size()) < k && !candidates.empty()) {
+        accepted.push_back(candidates.begin()->second);
+        acceptedCosts.push_back(candidates.begin()->first);
+        candidates.erase(candidates.begin());
+        if (static_cast<int>(accepted.size()) == k) {
+            break;
+        }
+
+        // 以上一条路径的每个节点为偏离点，生成新的候选路径
+        const std::vector<int>& previous = accepted.back();
+        double rootCost = 0.0;
+        for (size_t i = 0; i + 1 < previous.size(); ++i) {
+            if (isCancelled()) {
+                break;
+            }
+            int spur = previous[i];
+
+            // 与当前根路径相同的已确定路径，禁用它们在偏离点之后的第一条边
+            std::vector<std::pair<int, int>> bannedEdges;
+            for (const auto& path : accepted) {
+                if (path.size() > i + 1 && std::equal(previous.begin(), previous.begin() + i + 1, path.begin())) {
+                    setArcBanned(path[i], path[i + 1], 1);
+                    bannedEdges.emplace_back(path[i], path[i + 1]);
+                }
+            }
+            // 根路径上的节点（偏离点除外）不能再次经过，保证路径无环
+            for (size_t j = 0; j < i; ++j) {
+                bannedNodes[previous[j]] = 1;
+            }
+
+            std::vector<int> spurPath;
+            double spurCost = kInfinity;
+            if (treeDetour(spur, spurPath, spurCost)) {
+                ++treeReuses;
+            } else {
+                spurPath.clear();
+                spurCost = kInfinity;
+                ++spurSearches;
+                RouteResult route = engine.shortestPathConstrained(graph->vexNum(spur), dst, constraints);
+                if (route.found) {
+                    for (int vexNum : route.path) {
+                        spurPath.push_back(graph->indexOf(vexNum));
+                    }
+                    spurCost = route.distance;
+                }
+            }
+
+            for (const auto& edge : bannedEdges) {
+                setArcBanned(edge.first, edge.second, 0);
+            }
+            for (size_t j = 0; j < i; ++j) {
+                bannedNodes[previous[j]] = 0;
+            }
+
+            if (spurCost != kInfinity) {
+                std::vector<int> candidate(previous.begin(), previous.begin() + i);
+                candidate.insert(candidate.end(), spurPath.begin(), spurPath.end());
+                if (seen.insert(candidate).second) {
+                    candidates.emplace(rootCost + spurCost, std::move(candidate));
+                }
+            }
+            rootCost += graph->weights[arcIndex(previous[i], previous[i + 1])];
+        }
+        if (isCancelled()) {
+            break;
+        }
+    }
+
+    Profiler::count("yen.spurSearches", spurSearches);
+    Profiler::count("yen.treeReuses", treeReuses);
+    for (size_t p = 0; p < accepted.size(); ++p) {
+        RouteResult route;
+        route.found = true;
+        route.distance = acceptedCosts[p];
+        for (int index : accepted[p]) {
+            route.path.push_back(graph->vexNum(index));
+        }
+        result.push_back(std::move(route));
+    }
+    return result;
+}
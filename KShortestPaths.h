@@ -0,0 +1,41 @@
+#ifndef KSHORTESTPATHS_H
+#define KSHORTESTPATHS_H
+
+#include "Graph.h"
+#include "RoutingEngine.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// 前 k 条最短简单路径（Yen 算法），在不可变的CSR快照上运行
+// 先求一棵以终点为根的最短路径树，在各次偏离之间复用：偏离点先走一条允许的边、
+// 再沿树到达终点的最短走法若不经过被禁用的节点和边，它就是该次偏离的最短路径，无需搜索；
+// 否则用树上的距离作为 A* 启发函数，在禁用相应节点和边后搜索
+class KShortestPaths {
+public:
+    explicit KShortestPaths(std::shared_ptr<const CsrGraph> graph); // 构造函数
+
+    // 按长度升序返回至多 k 条从 src 到 dst 的简单路径（参数为节点编号），不可达时为空
+    std::vector<RouteResult> find(int src, int dst, int k);
+    void setCancelFlag(const std::atomic_bool* flag); // 设置取消标志，置位后返回已找到的路径
+    int spurSearchCount() const;             // 上次查询实际执行的偏离搜索次数
+    int treeReuseCount() const;              // 上次查询直接使用最短路径树的偏离次数
+
+private:
+    bool isCancelled() const;
+    int arcIndex(int from, int to) const;    // 边 from -> to 在 CSR 中的位置
+    void setArcBanned(int from, int to, char banned); // 同时设置无向边两个方向的禁用状态
+    bool treeDetour(int spur, std::vector<int>& path, double& cost) const; // 尝试直接由最短路径树得到偏离路径
+
+    std::shared_ptr<const CsrGraph> graph;   // 邻接快照
+    const std::atomic_bool* cancelFlag;      // 取消标志（可为空）
+    RoutingEngine engine;
+    std::vector<double> toTarget;            // 稠密下标 -> 到终点的最短距离
+    std::vector<int> nextHop;                // 稠密下标 -> 树上朝终点方向的下一跳
+    std::vector<char> bannedNodes;           // 稠密下标 -> 是否禁止经过
+    std::vector<char> bannedArcs;            // CSR 边位置 -> 是否禁止通行
+    int spurSearches;
+    int treeReuses;
+};
+
+#endif // KSHORTESTPATHS_H
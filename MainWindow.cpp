@@ -1,17 +1,30 @@
 #include "MainWindow.h"
 #include "ui_MainWindow.h"
+#include "RoutingEngine.h"
+#include "MstEngine.h"
+#include "TourPlanner.h"
+#include "DistanceMatrix.h"
+#include "RouteCache.h"
+#include "DfsPathGenerator.h"
+#include "KShortestPaths.h"
+#include "QueryExecutor.h"
+#include "EdgeLayerItem.h"
+#include "graphicsview.h"
+#include "GraphIO.h"
+#include "GraphSnapshot.h"
+#include "Profiler.h"
+#include "StatsPanel.h"
 #include <QGraphicsTextItem>
 #include <QPen>
 #include <QMessageBox>
-#include <QDebug>
 #include <QGraphicsSceneMouseEvent>
 #include <QMouseEvent>
 #include <QPainter>
+#include <QStyleOptionGraphicsItem>
 #include <cmath>
 #include <random>
 #include <chrono>
 #include <functional>
-#include <queue>
 #include <set>
 #include <algorithm>
 #include <QPushButton>
@@ -21,17 +34,97 @@
 #include <QGraphicsView>
 #include <QTimer>
 #include <QFileDialog>
+#include <QStatusBar>
+#include <QElapsedTimer>
+#include <QRegularExpression>
+#include <QtConcurrent>
+
+namespace {
+const int kDfsMaxPaths = 1000;   // DFS 展示最多枚举的路径数
+const int kDfsMaxDepth = 64;     // DFS 展示路径最多包含的节点数
+const int kParallelMstThreshold = 20000; // 节点数达到该值时使用多线程 Borůvka
+const int kSceneChunkSize = 2000;        // 每批创建的节点图元或边数
+const int kImportProgressInterval = 100; // 导入进度的刷新间隔（毫秒）
+
+// 后台导入的阶段
+enum ImportStage { kImportReading, kImportParsing, kImportBuilding };
+
+// 后台最短路径查询的结果
+struct RouteAnswer {
+    RouteResult route;
+    int baselineSettled = 0;     // A* 模式下对照 Dijkstra 确定的节点数
+};
+
+// 在工作线程中读取并解析地图文件，建好图模型；文本格式的节点在地图范围内随机放置
+std::shared_ptr<ImportedGraph> loadGraphFile(const QString& fileName, std::shared_ptr<std::atomic_int> stage) {
+    auto result = std::make_shared<ImportedGraph>();
+    QElapsedTimer timer;
+    timer.start();
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        result->error = "无法打开文件！";
+        return result;
+    }
+
+    // 把整个文件映射到内存后一次性解析，边的名称直接引用映射区
+    QByteArray fallback;
+    const char* data = nullptr;
+    qint64 size = file.size();
+    if (size > 0) {
+        data = reinterpret_cast<const char*>(file.map(0, size));
+        if (!data) {
+            fallback = file.readAll();
+            data = fallback.constData();
+            size = fallback.size();
+        }
+    }
+    std::string_view bytes(data, static_cast<size_t>(size));
+
+    // 二进制快照：节点坐标与边权重直接取自文件，无需解析文本和重新计算
+    if (fileName.endsWith(".ctg", Qt::CaseInsensitive)) {
+        result->snapshot = true;
+        stage->store(kImportBuilding);
+        GraphSnapshot::load(bytes, result->graph, result->error);
+        result->parseMs = timer.nsecsElapsed() / 1e6;
+        return result;
+    }
+
+    stage->store(kImportParsing);
+    ParsedGraph parsed;
+    if (!GraphIO::parseText(bytes, parsed, result->error)) {
+        return result;
+    }
+
+    result->parseMs = timer.nsecsElapsed() / 1e6;
+    timer.restart();
+
+    stage->store(kImportBuilding);
+    unsigned int seed = static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count());
+    GraphIO::buildGraph(parsed, seed, result->graph);
+    result->buildMs = timer.nsecsElapsed() / 1e6;
+    return result;
+}
+
+// 后台推进一步DFS生成器的结果
+struct DfsStep {
+    bool found = false;
+    std::vector<int> path;
+    int index = 0;               // 当前是第几条路径
+    bool hitLimit = false;
+};
+}
 
 // DraggableEllipseItem 类的实现
 DraggableEllipseItem::DraggableEllipseItem(int nodeId, const QString& labelText, QGraphicsItem* parent)
     : QObject(), QGraphicsEllipseItem(parent), nodeId(nodeId), moved(false) {
-    setFlags(ItemIsMovable | ItemIsSelectable);
+    setFlags(ItemIsMovable | ItemIsSelectable | ItemSendsGeometryChanges);
     originalPosition = pos();
 
     // 创建标签并设置位置
-    label = new QGraphicsTextItem(labelText, this);
-    label->setDefaultTextColor(Qt::black);
-    label->setParentItem(this);
+    label.setText(labelText);
+    label.setPerformanceHint(QStaticText::AggressiveCaching);
+    label.prepare(QTransform(), QFont());
     updateLabelPosition();
 }
 
@@ -40,9 +133,36 @@ int DraggableEllipseItem::getNodeId() const {
 }
 
 void DraggableEllipseItem::updateLabelPosition() {
-    qreal x = rect().x() + rect().width() / 2 - label->boundingRect().width() / 2;
-    qreal y = rect().y() + rect().height() / 2 - label->boundingRect().height() / 2;
-    label->setPos(x, y);
+    qreal x = rect().x() + rect().width() / 2 - label.size().width() / 2;
+    qreal y = rect().y() + rect().height() / 2 - label.size().height() / 2;
+    if (labelOffset != QPointF(x, y)) {
+        prepareGeometryChange();
+        labelOffset = QPointF(x, y);
+    }
+}
+
+QRectF DraggableEllipseItem::boundingRect() const {
+    return QGraphicsEllipseItem::boundingRect() | QRectF(labelOffset, label.size());
+}
+
+void DraggableEllipseItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
+    qreal lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+
+    // 缩得很小时节点退化为固定屏幕大小的点，且不绘制标签
+    if (lod < GraphicsView::kNodeLodThreshold) {
+        qreal radius = qMin(2.0 / lod, rect().width() / 2);
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(brush());
+        painter->drawRect(QRectF(rect().center() - QPointF(radius, radius), QSizeF(2 * radius, 2 * radius)));
+        return;
+    }
+
+    QGraphicsEllipseItem::paint(painter, option, widget);
+    if (lod >= GraphicsView::kLabelLodThreshold) {
+        painter->setPen(Qt::black);
+        painter->setFont(QFont());
+        painter->drawStaticText(labelOffset, label);
+    }
 }
 
 void DraggableEllipseItem::mouseMoveEvent(QGraphicsSceneMouseEvent* event) {
@@ -51,25 +171,83 @@ void DraggableEllipseItem::mouseMoveEvent(QGraphicsSceneMouseEvent* event) {
     updateLabelPosition();
 }
 
+QVariant DraggableEllipseItem::itemChange(GraphicsItemChange change, const QVariant& value) {
+    // 多选拖动时 Qt 直接移动其他选中的节点，只有被抓取的节点收到鼠标事件，
+    // 因此在位置变化时发出通知，每个被移动的节点都会把自己标记为脏
+    if (change == ItemPositionHasChanged) {
+        emit positionChanging(nodeId);
+    }
+    return QGraphicsEllipseItem::itemChange(change, value);
+}
+
 void DraggableEllipseItem::mouseReleaseEvent(QGraphicsSceneMouseEvent* event) {
     QGraphicsEllipseItem::mouseReleaseEvent(event);
     if (moved) {
         moved = false;
-        emit positionChanged();
+        emit positionChanged(nodeId);
     }
 }
 
 // MainWindow 类的实现
 MainWindow::MainWindow(QWidget* parent)
-    : QMainWindow(parent), ui(new Ui::MainWindow), scene(new QGraphicsScene(this)), dfsTimer(nullptr) {
+    : QMainWindow(parent), ui(new Ui::MainWindow), scene(new QGraphicsScene(this)), edgeFlushTimer(new QTimer(this)),
+      dfsTimer(nullptr), isDfsRunning(false), alternativeIndex(0),
+      chWatcher(new QFutureWatcher<std::shared_ptr<ContractionHierarchy>>(this)),
+      matrixWatcher(new QFutureWatcher<std::shared_ptr<DistanceMatrix>>(this)), indexRebuildTimer(new QTimer(this)),
+      queryExecutor(new QueryExecutor(this)),
+      importWatcher(new QFutureWatcher<std::shared_ptr<ImportedGraph>>(this)),
+      importStage(std::make_shared<std::atomic_int>(kImportReading)), importProgressTimer(new QTimer(this)),
+      sceneBuildTimer(new QTimer(this)), sceneCursor(0) {
     ui->setupUi(this);
 
     // 设置地图范围
-    scene->setSceneRect(0, 0, 800, 600);
+    scene->setSceneRect(0, 0, GraphIO::kMapWidth, GraphIO::kMapHeight);
     ui->graphView->setScene(scene);
 
+    // 所有普通边由一个图元批量绘制
+    edgeLayer = new EdgeLayerItem();
+    scene->addItem(edgeLayer);
+
     // 连接信号和槽（仅保留必要的连接）
     connect(scene, &QGraphicsScene::selectionChanged, this, &MainWindow::on_nodeSelected);
+
+    // 编辑停止一段时间后再重建路径索引，避免拖动时反复重建
+    indexRebuildTimer->setSingleShot(true);
+    indexRebuildTimer->setInterval(500);
+    connect(indexRebuildTimer, &QTimer::timeout, this, &MainWindow::rebuildRouteIndex);
+    connect(chWatcher, &QFutureWatcher<std::shared_ptr<ContractionHierarchy>>::finished,
+            this, &MainWindow::onRouteIndexBuilt);
+    connect(matrixWatcher, &QFutureWatcher<std::shared_ptr<DistanceMatrix>>::finished,
+            this, &MainWindow::onDistanceMatrixBuilt);
+
+    // 拖动时合并鼠标移动事件，约每帧（16ms）刷新一次边的几何
+    edgeFlushTimer->setSingleShot(true);
+    edgeFlushTimer->setInterval(16);
+    connect(edgeFlushTimer, &QTimer::timeout, this, &MainWindow::flushDirtyEdges);
+
+    // 导入在后台进行，场景按批创建，期间定时显示进度
+    connect(importWatcher, &QFutureWatcher<std::shared_ptr<ImportedGraph>>::finished,
+            this, &MainWindow::onGraphImported);
+    importProgressTimer->setInterval(kImportProgressInterval);
+    connect(importProgressTimer, &QTimer::timeout, this, &MainWindow::updateImportProgress);
+    connect(sceneBuildTimer, &QTimer::timeout, this, &MainWindow::buildSceneChunk);
+
+    // 常驻状态栏的缓存命中统计
+    cacheStatusLabel = new QLabel(this);
+    statusBar()->addPermanentWidget(cacheStatusLabel);
+    updateCacheStatus();
+
+    statsPanel = new StatsPanel(this);
+    addDockWidget(Qt::RightDockWidgetArea, statsPanel);
+    statsPanel->hide();
+
+    connect(queryExecutor, &QueryExecutor::busyChanged, this, [this](bool busy) {
+        if (busy) {
+            statusBar()->showMessage("正在后台计算...");
+        } else {
+            statusBar()->clearMessage();
+        }
+    });
 }
 
 MainWindow::~MainWindow() {
@@ -77,6 +255,7 @@ MainWindow::~MainWindow() {
 }
 
 void MainWindow::on_addNodeButton_clicked() {
+    CAMPUS_PROFILE_SCOPE("ui.addNode");
     resetScene();
 
     QString nodeName = ui->nodeNameInput->text().trimmed();
@@ -106,27 +285,11 @@ void MainWindow::on_addNodeButton_clicked() {
         return;
     }
 
-    // 创建可拖动节点
-    DraggableEllipseItem* ellipse = new DraggableEllipseItem(nodeId, nodeName);
-    ellipse->setRect(-20, -20, 40, 40);
-
-    // 随机分配位置
-    QRectF sceneRect = scene->sceneRect();
-    static std::mt19937 generator(static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count()));
-    std::uniform_real_distribution<double> distributionX(sceneRect.left(), sceneRect.right());
-    std::uniform_real_distribution<double> distributionY(sceneRect.top(), sceneRect.bottom());
-    QPointF position(distributionX(generator), distributionY(generator));
-    ellipse->setPos(position);
-    ellipse->setBrush(Qt::green);
-    scene->addItem(ellipse);
-
-    // 插入到节点管理映射
-    nodeItems[nodeId] = ellipse;
-
-    // 绑定移动信号到槽函数
-    connect(ellipse, &DraggableEllipseItem::positionChanged, this, &MainWindow::on_sceneNodeMoved);
-
-    qDebug() << "节点添加成功，ID：" << nodeId << "名称：" << nodeName;
+    // 创建可拖动节点并随机分配位置
+    QPointF position = randomScenePosition();
+    graph.setVexPosition(nodeId, position.x(), position.y());
+    createNodeItem(nodeId, nodeName, position);
+    scheduleIndexRebuild();
 
     // 清空输入框
     ui->nodeNameInput->clear();
@@ -134,6 +297,7 @@ void MainWindow::on_addNodeButton_clicked() {
 }
 
 void MainWindow::on_deleteNodeButton_clicked() {
+    CAMPUS_PROFILE_SCOPE("ui.deleteNode");
     resetScene();
 
     QString nodeName = ui->nodeNameInput->text().trimmed();
@@ -149,32 +313,21 @@ void MainWindow::on_deleteNodeButton_clicked() {
         return;
     }
 
-    // 删除与该节点相关的边
-    auto adjacencyList = graph.getAdjacencyList();
-    if (adjacencyList.find(nodeId) != adjacencyList.end()) {
-        for (const auto& neighbor : adjacencyList[nodeId]) {
-            int neighborId = neighbor.first;
-            int minId = std::min(nodeId, neighborId);
-            int maxId = std::max(nodeId, neighborId);
-
-            // 删除边的图形表示
-            if (edgeItems.find({minId, maxId}) != edgeItems.end()) {
-                scene->removeItem(edgeItems[{minId, maxId}]);
-                delete edgeItems[{minId, maxId}];
-                edgeItems.erase({minId, maxId});
-            }
+    // 从图数据结构中删除节点，并取回被一并删除的边
+    std::vector<Edge> removedEdges;
+    graph.removeVex(nodeId, &removedEdges);
+    scheduleIndexRebuild();
 
-            // 删除边权重的文本
-            if (edgeWeightTexts.find({minId, maxId}) != edgeWeightTexts.end()) {
-                scene->removeItem(edgeWeightTexts[{minId, maxId}]);
-                delete edgeWeightTexts[{minId, maxId}];
-                edgeWeightTexts.erase({minId, maxId});
-            }
+    // 删除边的图形表示（线段与权重在同一图层中）
+    for (const auto& edge : removedEdges) {
+        edgeLayer->removeEdge(edge.vex1, edge.vex2);
+        if (ui->liveMstCheckBox->isChecked()) {
+            liveMst.removeEdge(edge.vex1, edge.vex2);
         }
     }
-
-    // 从图数据结构中删除节点
-    graph.removeVex(nodeId);
+    if (ui->liveMstCheckBox->isChecked()) {
+        applyLiveMstChanges();
+    }
 
     // 删除节点的图形表示
     if (nodeItems.find(nodeId) != nodeItems.end()) {
@@ -188,6 +341,7 @@ void MainWindow::on_deleteNodeButton_clicked() {
 }
 
 void MainWindow::on_addEdgeButton_clicked() {
+    CAMPUS_PROFILE_SCOPE("ui.addEdge");
     resetScene();
 
     QString startName = ui->edgeStartInput->text().trimmed();
@@ -214,7 +368,7 @@ void MainWindow::on_addEdgeButton_clicked() {
     int minId = std::min(startId, endId);
     int maxId = std::max(startId, endId);
 
-    if (edgeItems.find({minId, maxId}) != edgeItems.end()) {
+    if (edgeLayer->hasEdge(minId, maxId)) {
         QMessageBox::warning(this, "警告", "这条边已存在！");
         return;
     }
@@ -225,19 +379,14 @@ void MainWindow::on_addEdgeButton_clicked() {
 
     // 添加到图数据结构中
     graph.addEdge(minId, maxId, distance);
+    scheduleIndexRebuild();
 
-    // 绘制边
-    QPen pen(Qt::gray);
-    pen.setWidth(2);
-    QGraphicsLineItem* line = scene->addLine(QLineF(pos1, pos2), pen);
-    edgeItems[{minId, maxId}] = line;
-
-    // 显示边权重
-    QPointF midPoint = (pos1 + pos2) / 2;
-    QGraphicsTextItem* text = scene->addText(QString::number(distance, 'f', 2));
-    text->setDefaultTextColor(Qt::blue);
-    text->setPos(midPoint);
-    edgeWeightTexts[{minId, maxId}] = text;
+    // 绘制边及其权重
+    edgeLayer->setEdge(minId, maxId, pos1, pos2, distance);
+    if (ui->liveMstCheckBox->isChecked()) {
+        liveMst.insertEdge(minId, maxId, distance);
+        applyLiveMstChanges();
+    }
 
     // 清空输入框
     ui->edgeStartInput->clear();
@@ -245,6 +394,7 @@ void MainWindow::on_addEdgeButton_clicked() {
 }
 
 void MainWindow::on_deleteEdgeButton_clicked() {
+    CAMPUS_PROFILE_SCOPE("ui.deleteEdge");
     resetScene();
     QString startName = ui->edgeStartInput->text().trimmed();
     QString endName = ui->edgeEndInput->text().trimmed();
@@ -270,18 +420,15 @@ void MainWindow::on_deleteEdgeButton_clicked() {
     int maxId = std::max(startId, endId);
 
     // 检查边是否存在
-    if (edgeItems.find({minId, maxId}) != edgeItems.end()) {
-        scene->removeItem(edgeItems[{minId, maxId}]);
-        delete edgeItems[{minId, maxId}];
-        edgeItems.erase({minId, maxId});
-
-        if (edgeWeightTexts.find({minId, maxId}) != edgeWeightTexts.end()) {
-            scene->removeItem(edgeWeightTexts[{minId, maxId}]);
-            delete edgeWeightTexts[{minId, maxId}];
-            edgeWeightTexts.erase({minId, maxId});
-        }
+    if (edgeLayer->hasEdge(minId, maxId)) {
+        edgeLayer->removeEdge(minId, maxId);
 
         graph.removeEdge(startId, endId);
+        if (ui->liveMstCheckBox->isChecked()) {
+            liveMst.removeEdge(minId, maxId);
+            applyLiveMstChanges();
+        }
+        scheduleIndexRebuild();
     } else {
         QMessageBox::warning(this, "警告", "这条边不存在！");
         return;
@@ -291,36 +438,83 @@ void MainWindow::on_deleteEdgeButton_clicked() {
     ui->edgeEndInput->clear();
 }
 
-void MainWindow::on_sceneNodeMoved() {
-    for (auto& pair : edgeItems) {
-        int id1 = pair.first.first;
-        int id2 = pair.first.second;
+void MainWindow::on_sceneNodeMoved(int nodeId) {
+    CAMPUS_PROFILE_SCOPE("ui.nodeMoved");
+    // 拖动结束时立即刷新所有移动过的节点（包括多选时一起移动的节点），无需等待下一帧；
+    // 刷新时同步坐标到图模型（A* 启发函数依赖该坐标）并只更新相连的边
+    dirtyNodes.insert(nodeId);
+    flushDirtyEdges();
+    scheduleIndexRebuild();
+}
+
+void MainWindow::on_sceneNodeMoving(int nodeId) {
+    dirtyNodes.insert(nodeId);
+    if (!edgeFlushTimer->isActive()) {
+        edgeFlushTimer->start();
+    }
+}
 
-        if (nodeItems.find(id1) == nodeItems.end() || nodeItems.find(id2) == nodeItems.end()) {
-            qWarning() << "节点未正确添加，无法更新边位置！";
+void MainWindow::flushDirtyEdges() {
+    CAMPUS_PROFILE_SCOPE("scene.flushEdges");
+    // 汇总所有脏节点相连的边，两端都在移动的边只更新一次
+    std::set<std::pair<int, int>> dirtyEdges;
+    for (int nodeId : dirtyNodes) {
+        auto nodeIt = nodeItems.find(nodeId);
+        if (nodeIt == nodeItems.end()) {
             continue;
         }
+        QPointF pos = nodeIt->second->pos();
+        graph.setVexPosition(nodeId, pos.x(), pos.y());
 
-        QPointF pos1 = nodeItems[id1]->pos();
-        QPointF pos2 = nodeItems[id2]->pos();
+        for (int neighborId : graph.getNeighbors(nodeId)) {
+            dirtyEdges.insert({std::min(nodeId, neighborId), std::max(nodeId, neighborId)});
+        }
+    }
+    dirtyNodes.clear();
 
-        double distance = calculateDistance(pos1, pos2);
-        graph.updateEdgeWeight(id1, id2, distance);
+    for (const auto& edgeKey : dirtyEdges) {
+        updateEdgeGeometry(edgeKey.first, edgeKey.second);
+    }
 
-        if (pair.second) {
-            pair.second->setLine(QLineF(pos1, pos2));
-        } else {
-            qWarning() << "边图形未正确初始化！";
-            continue;
+    // 整批权重更新完后再同步实时最小生成树的覆盖层和状态栏，每帧只做一次
+    if (ui->liveMstCheckBox->isChecked() && !dirtyEdges.empty()) {
+        applyLiveMstChanges();
+        for (const auto& edgeKey : dirtyEdges) {
+            auto treeEdge = liveMstItems.find(edgeKey);
+            if (treeEdge != liveMstItems.end()) {
+                QLineF line(nodeItems[edgeKey.first]->pos(), nodeItems[edgeKey.second]->pos());
+                treeEdge->second->setLine(line);
+            }
         }
+    }
+}
 
-        if (edgeWeightTexts.find(pair.first) != edgeWeightTexts.end() && edgeWeightTexts[pair.first]) {
-            QPointF midPoint = (pos1 + pos2) / 2;
-            edgeWeightTexts[pair.first]->setPlainText(QString::number(distance, 'f', 2));
-            edgeWeightTexts[pair.first]->setPos(midPoint);
-        } else {
-            qWarning() << "边权重文本未正确初始化！";
-        }
+void MainWindow::updateEdgeGeometry(int id1, int id2) {
+    Profiler::count("scene.edgeGeometryUpdates");
+    auto edgeKey = std::make_pair(std::min(id1, id2), std::max(id1, id2));
+
+    if (nodeItems.find(id1) == nodeItems.end() || nodeItems.find(id2) == nodeItems.end()) {
+        Profiler::count("scene.edgesMissingNode"); // 端点节点尚未创建图元
+        return;
+    }
+
+    QPointF pos1 = nodeItems[edgeKey.first]->pos();
+    QPointF pos2 = nodeItems[edgeKey.second]->pos();
+
+    double distance = calculateDistance(pos1, pos2);
+    graph.updateEdgeWeight(edgeKey.first, edgeKey.second, distance);
+
+    edgeLayer->setEdge(edgeKey.first, edgeKey.second, pos1, pos2, distance);
+
+    // 高亮中的边也随之移动
+    auto highlight = highlightItems.find(edgeKey);
+    if (highlight != highlightItems.end()) {
+        highlight->second->setLine(QLineF(pos1, pos2));
+    }
+
+    // 权重变化可能让树边被替换；覆盖层由 flushDirtyEdges 在整批更新后统一同步
+    if (ui->liveMstCheckBox->isChecked()) {
+        liveMst.updateWeight(edgeKey.first, edgeKey.second, distance);
     }
 }
 
@@ -328,6 +522,32 @@ double MainWindow::calculateDistance(const QPointF& p1, const QPointF& p2) {
     return std::hypot(p1.x() - p2.x(), p1.y() - p2.y());
 }
 
+void MainWindow::highlightEdge(int v1, int v2, const QColor& color) {
+    auto edgeKey = std::make_pair(std::min(v1, v2), std::max(v1, v2));
+    if (!edgeLayer->hasEdge(edgeKey.first, edgeKey.second) || highlightItems.count(edgeKey)) {
+        return;
+    }
+
+    QLineF line(nodeItems[edgeKey.first]->pos(), nodeItems[edgeKey.second]->pos());
+    QGraphicsLineItem* item = scene->addLine(line, QPen(color, 4));
+    item->setZValue(-0.5); // 位于普通边之上、节点之下
+    highlightItems[edgeKey] = item;
+}
+
+void MainWindow::highlightPath(const std::vector<int>& path, const QColor& color) {
+    for (size_t i = 0; i + 1 < path.size(); ++i) {
+        highlightEdge(path[i], path[i + 1], color);
+    }
+}
+
+void MainWindow::clearHighlights() {
+    for (auto& pair : highlightItems) {
+        scene->removeItem(pair.second);
+        delete pair.second;
+    }
+    highlightItems.clear();
+}
+
 void MainWindow::on_nodeSelected() {
     QList<QGraphicsItem*> selectedItems = scene->selectedItems();
     if (!selectedItems.isEmpty()) {
@@ -345,6 +565,7 @@ void MainWindow::on_nodeSelected() {
 }
 
 void MainWindow::on_findShortestPathButton_clicked() {
+    CAMPUS_PROFILE_SCOPE("ui.findShortestPath");
     resetScene();
     if (graph.getAllVexs().size() < 2) {
         QMessageBox::warning(this, "警告", "节点少于2个时，无法查询最短路径！");
@@ -367,51 +588,85 @@ void MainWindow::on_findShortestPathButton_clicked() {
         return;
     }
 
-    auto adjacencyList = graph.getAdjacencyList();
-    std::map<int, double> distances;
-    std::map<int, int> previous;
-    std::set<int> visited;
+    // 图未被修改过的重复查询直接使用缓存结果
+    std::uint64_t version = graph.version();
+    RouteResult cached;
+    if (routeCache.lookup(startIdx, endIdx, version, cached)) {
+        showRoute(cached, "\n（缓存命中）");
+        return;
+    }
 
-    for (const auto& vexPair : adjacencyList) {
-        distances[vexPair.first] = std::numeric_limits<double>::infinity();
+    // 距离矩阵与当前边版本一致时直接查表
+    if (ui->apspCheckBox->isChecked() && distanceMatrix && distanceMatrix->edgeVersion() == graph.edgeVersion()) {
+        RouteResult route = distanceMatrix->route(startIdx, endIdx);
+        routeCache.insert(startIdx, endIdx, version, route);
+        showRoute(route, "\n（距离矩阵查表）");
+        return;
     }
-    distances[startIdx] = 0;
 
-    auto cmp = [&distances](int left, int right) { return distances[left] > distances[right]; };
-    std::priority_queue<int, std::vector<int>, decltype(cmp)> queue(cmp);
-    queue.push(startIdx);
+    auto csr = graph.getCsrGraph();
+    bool useAStar = ui->aStarCheckBox->isChecked();
+    bool useCh = ui->chCheckBox->isChecked() && chIndex && chIndex->isBuiltFor(csr.get());
 
-    while (!queue.empty()) {
-        int current = queue.top();
-        queue.pop();
+    if (useCh) {
+        // CH 查询为亚毫秒级且复用索引内的工作区，直接在界面线程执行
+        RouteResult route = chIndex->shortestPath(startIdx, endIdx);
+        routeCache.insert(startIdx, endIdx, version, route);
+        showRoute(route, QString("\nCH确定节点数：%1").arg(route.settledCount));
+        return;
+    }
 
-        if (visited.find(current) != visited.end()) continue;
-        visited.insert(current);
+    bool chPending = ui->chCheckBox->isChecked();
+    ui->outputDisplay->setText("正在计算最短路径...");
+    queryExecutor->submit<RouteAnswer>(
+        [csr, startIdx, endIdx, useAStar](const std::atomic_bool& cancelled) {
+            RoutingEngine engine(csr);
+            engine.setCancelFlag(&cancelled);
+            RouteAnswer answer;
+            if (useAStar) {
+                answer.route = engine.shortestPathAStar(startIdx, endIdx);
+                // 同时运行一次 Dijkstra，对比两者确定的节点数
+                answer.baselineSettled = engine.shortestPath(startIdx, endIdx).settledCount;
+            } else {
+                answer.route = engine.shortestPath(startIdx, endIdx);
+            }
+            return answer;
+        },
+        [this, useAStar, chPending, startIdx, endIdx, version](const RouteAnswer& answer) {
+            routeCache.insert(startIdx, endIdx, version, answer.route);
+            QString detail;
+            if (useAStar) {
+                detail = QString("\nA*确定节点数：%1（Dijkstra：%2）")
+                             .arg(answer.route.settledCount)
+                             .arg(answer.baselineSettled);
+            } else {
+                detail = QString("\n确定节点数：%1").arg(answer.route.settledCount);
+            }
+            if (chPending) {
+                detail += "\n（CH索引尚未就绪，已使用普通搜索）";
+            }
+            showRoute(answer.route, detail);
+        });
+}
 
-        for (const auto& neighbor : adjacencyList[current]) {
-            int neighborIdx = neighbor.first;
-            double weight = neighbor.second;
-            double newDist = distances[current] + weight;
+void MainWindow::updateCacheStatus() {
+    cacheStatusLabel->setText(QString("路径缓存：%1/%2 条，命中 %3，未命中 %4")
+                                  .arg(routeCache.size())
+                                  .arg(routeCache.capacity())
+                                  .arg(routeCache.hits())
+                                  .arg(routeCache.misses()));
+}
 
-            if (newDist < distances[neighborIdx]) {
-                distances[neighborIdx] = newDist;
-                previous[neighborIdx] = current;
-                queue.push(neighborIdx);
-            }
-        }
-    }
+void MainWindow::showRoute(const RouteResult& route, const QString& detail) {
+    CAMPUS_PROFILE_SCOPE("scene.showRoute");
+    updateCacheStatus();
 
-    if (distances[endIdx] == std::numeric_limits<double>::infinity()) {
+    if (!route.found) {
         ui->outputDisplay->setText("无法到达目标节点！");
         return;
     }
 
-    std::vector<int> path;
-    for (int at = endIdx; at != startIdx; at = previous[at]) {
-        path.push_back(at);
-    }
-    path.push_back(startIdx);
-    std::reverse(path.begin(), path.end());
+    const std::vector<int>& path = route.path;
 
     QString pathStr = "最短路径：\n";
     for (size_t i = 0; i < path.size(); ++i) {
@@ -420,23 +675,16 @@ void MainWindow::on_findShortestPathButton_clicked() {
             pathStr += " -> ";
         }
     }
-    pathStr += QString("\n总距离：%1").arg(distances[endIdx], 0, 'f', 2);
+    pathStr += QString("\n总距离：%1").arg(route.distance, 0, 'f', 2);
+    pathStr += detail;
     ui->outputDisplay->setText(pathStr);
 
-    for (auto& edgePair : edgeItems) {
-        edgePair.second->setPen(QPen(Qt::gray, 2));
-    }
-    for (size_t i = 0; i < path.size() - 1; ++i) {
-        int minId = std::min(path[i], path[i + 1]);
-        int maxId = std::max(path[i], path[i + 1]);
-        auto edgeKey = std::make_pair(minId, maxId);
-        if (edgeItems.find(edgeKey) != edgeItems.end()) {
-            edgeItems[edgeKey]->setPen(QPen(Qt::red, 4));
-        }
-    }
+    clearHighlights();
+    highlightPath(path, Qt::red);
 }
 
 void MainWindow::on_dfsButton_clicked() {
+    CAMPUS_PROFILE_SCOPE("ui.dfs");
     if (graph.getAllVexs().size() < 1) {
         QMessageBox::warning(this, "警告", "图中没有节点，无法执行DFS！");
         return;
@@ -455,333 +703,650 @@ void MainWindow::on_dfsButton_clicked() {
         return;
     }
 
-    // 如果正在运行DFS展示，先停止
-    if (dfsTimer && dfsTimer->isActive()) {
-        dfsTimer->stop();
-        delete dfsTimer;
-        dfsTimer = nullptr;
-    }
-
     resetScene();
 
-    auto adjacencyList = graph.getAdjacencyList();
-    std::set<int> visited;
-    std::vector<int> currentPath;
-
-    dfsPaths.clear();
-
-    // 深度优先搜索的递归函数
-    std::function<void(int)> dfs = [&](int current) {
-        visited.insert(current);
-        currentPath.push_back(current);
-
-        bool hasUnvisited = false;
-        for (const auto& neighbor : adjacencyList[current]) {
-            if (visited.find(neighbor.first) == visited.end()) {
-                hasUnvisited = true;
-                dfs(neighbor.first);
-            }
-        }
-
-        if (!hasUnvisited) {
-            dfsPaths.push_back(currentPath);
-        }
-
-        visited.erase(current);
-        currentPath.pop_back();
-    };
-
-    // 执行DFS
-    dfs(startIdx);
-
-    if (dfsPaths.empty()) {
-        ui->outputDisplay->setText("未找到任何DFS路径！");
-        return;
-    }
+    // 路径由生成器按需产生，定时器每次只取下一条，不再一次性枚举全部路径
+    dfsGenerator = std::make_shared<DfsPathGenerator>(graph.getCsrGraph(), startIdx,
+                                                      kDfsMaxPaths, kDfsMaxDepth);
 
     // 开始路径展示
-    dfsPathIndex = 0;
     isDfsRunning = true;
 
     dfsTimer = new QTimer(this);
-    connect(dfsTimer, &QTimer::timeout, this, [this]() {
-        if (!dfsPaths.empty() && dfsPathIndex < static_cast<int>(dfsPaths.size())) {
-            // 重置所有边的颜色
-            for (auto& edgePair : edgeItems) {
-                edgePair.second->setPen(QPen(Qt::gray, 2));
-            }
+    connect(dfsTimer, &QTimer::timeout, this, &MainWindow::advanceDfsPath);
+    dfsTimer->start(2000); // 每2秒切换一条路径
+}
 
-            // 获取当前路径并高亮显示
-            const auto& path = dfsPaths[dfsPathIndex];
-            QColor pathColor(Qt::red);
-            for (size_t i = 0; i < path.size() - 1; ++i) {
-                int node1 = path[i];
-                int node2 = path[i + 1];
-                int minId = std::min(node1, node2);
-                int maxId = std::max(node1, node2);
-                auto edgeKey = std::make_pair(minId, maxId);
-
-                if (edgeItems.find(edgeKey) != edgeItems.end()) {
-                    edgeItems[edgeKey]->setPen(QPen(pathColor, 4));
-                }
+void MainWindow::advanceDfsPath() {
+    CAMPUS_PROFILE_SCOPE("scene.dfsStep");
+    if (!dfsGenerator || queryExecutor->isBusy()) {
+        return; // 上一条路径仍在后台生成
+    }
+
+    // 生成器只在工作线程中推进，界面线程只持有引用
+    std::shared_ptr<DfsPathGenerator> generator = dfsGenerator;
+    queryExecutor->submit<DfsStep>(
+        [generator](const std::atomic_bool& cancelled) {
+            DfsStep step;
+            generator->setCancelFlag(&cancelled);
+            step.found = generator->next(step.path);
+            if (!step.found && !cancelled && generator->producedCount() > 0) {
+                generator->restart(); // 循环展示
+                step.found = generator->next(step.path);
+            }
+            generator->setCancelFlag(nullptr);
+            step.index = generator->producedCount();
+            step.hitLimit = generator->hitLimit();
+            return step;
+        },
+        [this](const DfsStep& step) {
+            if (!isDfsRunning) {
+                return;
+            }
+            if (!step.found) {
+                dfsTimer->stop();
+                ui->outputDisplay->setText("未找到任何DFS路径！");
+                return;
             }
 
+            // 重置高亮并高亮当前路径
+            const auto& path = step.path;
+            clearHighlights();
+            highlightPath(path, Qt::red);
+
             // 显示路径的文字信息
-            QString result = "当前路径：";
+            QString result = QString("当前路径（第%1条）：").arg(step.index);
             for (size_t i = 0; i < path.size(); ++i) {
                 result += QString::fromStdString(graph.getVex(path[i]).name);
                 if (i != path.size() - 1) {
                     result += " -> ";
                 }
             }
+            if (step.hitLimit) {
+                result += QString("\n（已达到路径数上限%1或深度上限%2，部分路径未展示）")
+                              .arg(kDfsMaxPaths)
+                              .arg(kDfsMaxDepth);
+            }
             ui->outputDisplay->setText(result);
+        });
+}
 
-            // 准备展示下一条路径
-            dfsPathIndex++;
-            if (dfsPathIndex >= static_cast<int>(dfsPaths.size())) {
-                dfsPathIndex = 0; // 循环展示
-            }
-        }
-    });
+void MainWindow::on_kPathsButton_clicked() {
+    CAMPUS_PROFILE_SCOPE("ui.kPaths");
+    QString startName = ui->startPointInput->text().trimmed();
+    QString endName = ui->endPointInput->text().trimmed();
 
-    dfsTimer->start(2000); // 每2秒切换一条路径
-}
+    if (startName.isEmpty() || endName.isEmpty()) {
+        QMessageBox::warning(this, "警告", "起点或终点名称不能为空！");
+        return;
+    }
+
+    int startIdx = graph.getVexIndex(startName.toStdString());
+    int endIdx = graph.getVexIndex(endName.toStdString());
+
+    if (startIdx == -1 || endIdx == -1) {
+        QMessageBox::warning(this, "警告", "起点或终点不存在！");
+        return;
+    }
+    if (startIdx == endIdx) {
+        QMessageBox::warning(this, "警告", "起点和终点不能相同！");
+        return;
+    }
 
-void MainWindow::on_mstButton_clicked() {
     resetScene();
-    // 实现Kruskal算法计算最小生成树
-    auto allEdges = graph.getAllEdges();
-    std::sort(allEdges.begin(), allEdges.end(), [](const Edge& e1, const Edge& e2) {
-        return e1.weight < e2.weight;
-    });
 
-    std::map<int, int> parent;
-    for (const auto& vex : graph.getAllVexs()) {
-        parent[vex.num] = vex.num;
+    auto snapshot = graph.getCsrGraph();
+    int k = ui->kPathsSpinBox->value();
+
+    ui->outputDisplay->setText("正在计算备选路线...");
+    queryExecutor->submit<std::vector<RouteResult>>(
+        [snapshot, startIdx, endIdx, k](const std::atomic_bool& cancelled) {
+            KShortestPaths finder(snapshot);
+            finder.setCancelFlag(&cancelled);
+            return finder.find(startIdx, endIdx, k);
+        },
+        [this](const std::vector<RouteResult>& routes) {
+            if (routes.empty()) {
+                ui->outputDisplay->setText("无法到达目标节点！");
+                return;
+            }
+
+            // 复用 DFS 展示的定时器，轮流展示各条路线；先停掉仍在驱动输出的旧定时器
+            stopDisplayTimer();
+            isDfsRunning = false;
+            dfsGenerator.reset();
+            alternativeRoutes = routes;
+            alternativeIndex = 0;
+            advanceAlternativeRoute();
+            if (alternativeRoutes.size() > 1) {
+                dfsTimer = new QTimer(this);
+                connect(dfsTimer, &QTimer::timeout, this, &MainWindow::advanceAlternativeRoute);
+                dfsTimer->start(2000); // 每2秒切换一条路线
+            }
+        });
+}
+
+void MainWindow::advanceAlternativeRoute() {
+    CAMPUS_PROFILE_SCOPE("scene.alternativeRoute");
+    if (alternativeRoutes.empty()) {
+        return;
     }
 
-    std::function<int(int)> findSet = [&](int u) {
-        if (parent[u] != u)
-            parent[u] = findSet(parent[u]);
-        return parent[u];
-    };
+    const RouteResult& route = alternativeRoutes[alternativeIndex];
+    clearHighlights();
+    highlightPath(route.path, Qt::red);
 
-    std::vector<Edge> mstEdges;
-    for (const auto& edge : allEdges) {
-        int uSet = findSet(edge.vex1);
-        int vSet = findSet(edge.vex2);
-        if (uSet != vSet) {
-            mstEdges.push_back(edge);
-            parent[uSet] = vSet;
+    QString result = QString("备选路线（第%1/%2条）：\n").arg(alternativeIndex + 1).arg(alternativeRoutes.size());
+    for (size_t i = 0; i < route.path.size(); ++i) {
+        result += QString::fromStdString(graph.getVex(route.path[i]).name);
+        if (i != route.path.size() - 1) {
+            result += " -> ";
         }
     }
+    result += QString("\n总距离：%1").arg(route.distance, 0, 'f', 2);
+    if (alternativeIndex > 0) {
+        result += QString("（比最短路线多 %1）").arg(route.distance - alternativeRoutes.front().distance, 0, 'f', 2);
+    }
+    ui->outputDisplay->setText(result);
+
+    alternativeIndex = (alternativeIndex + 1) % alternativeRoutes.size();
+}
+
+void MainWindow::on_mstButton_clicked() {
+    CAMPUS_PROFILE_SCOPE("ui.mst");
+    resetScene();
+
+    // 在工作线程中对不可变快照求最小生成森林，大图使用多线程 Borůvka
+    auto snapshot = graph.getCsrGraph();
+
+    ui->outputDisplay->setText("正在计算最小生成树...");
+    queryExecutor->submit<MstResult>(
+        [snapshot](const std::atomic_bool& cancelled) {
+            MstEngine engine(snapshot);
+            engine.setCancelFlag(&cancelled);
+            return snapshot->size() >= kParallelMstThreshold ? engine.boruvka() : engine.kruskal();
+        },
+        [this](const MstResult& mst) {
+            showMst(mst);
+        });
+}
 
+void MainWindow::showMst(const MstResult& mst) {
+    CAMPUS_PROFILE_SCOPE("scene.showMst");
     // 在界面上显示最小生成树的边
     QString mstStr = "最小生成树的边：\n";
-    double totalWeight = 0;
-    for (const auto& edge : mstEdges) {
+    for (const auto& edge : mst.edges) {
         QString startName = QString::fromStdString(graph.getVex(edge.vex1).name);
         QString endName = QString::fromStdString(graph.getVex(edge.vex2).name);
         mstStr += QString("%1 - %2，权重：%3\n").arg(startName).arg(endName).arg(edge.weight, 0, 'f', 2);
-        totalWeight += edge.weight;
     }
-    mstStr += QString("总权重：%1").arg(totalWeight, 0, 'f', 2);
+    mstStr += QString("总权重：%1").arg(mst.totalWeight, 0, 'f', 2);
+    if (mst.componentCount > 1) {
+        mstStr += QString("\n图不连通，结果为包含 %1 个连通分量的最小生成森林").arg(mst.componentCount);
+    }
     ui->outputDisplay->setText(mstStr);
 
     // 在地图上高亮最小生成树的边
-    for (auto& edgePair : edgeItems) {
-        edgePair.second->setPen(QPen(Qt::gray, 2));
-    }
-    for (const auto& edge : mstEdges) {
-        int minId = std::min(edge.vex1, edge.vex2);
-        int maxId = std::max(edge.vex1, edge.vex2);
-        auto edgeKey = std::make_pair(minId, maxId);
-        if (edgeItems.find(edgeKey) != edgeItems.end()) {
-            edgeItems[edgeKey]->setPen(QPen(Qt::green, 4));
+    clearHighlights();
+    for (const auto& edge : mst.edges) {
+        highlightEdge(edge.vex1, edge.vex2, Qt::green);
+    }
+}
+
+void MainWindow::on_tourButton_clicked() {
+    CAMPUS_PROFILE_SCOPE("ui.tour");
+    resetScene();
+
+    // 景点名称不含空白，允许用中英文逗号、顿号或空白分隔
+    QStringList names = ui->tourStopsInput->text().split(QRegularExpression("[,，、\\s]+"), Qt::SkipEmptyParts);
+    if (names.size() < 2) {
+        QMessageBox::warning(this, "警告", "请至少输入2个景点！");
+        return;
+    }
+
+    std::vector<int> stops;
+    for (const QString& name : names) {
+        int idx = graph.getVexIndex(name.toStdString());
+        if (idx == -1) {
+            QMessageBox::warning(this, "警告", QString("景点“%1”不存在！").arg(name));
+            return;
         }
+        stops.push_back(idx);
     }
+
+    auto snapshot = graph.getCsrGraph();
+    bool returnToStart = ui->tourReturnCheckBox->isChecked();
+
+    ui->outputDisplay->setText("正在规划游览路线...");
+    queryExecutor->submit<TourResult>(
+        [snapshot, stops, returnToStart](const std::atomic_bool& cancelled) {
+            TourPlanner planner(snapshot);
+            planner.setCancelFlag(&cancelled);
+            return planner.plan(stops, returnToStart);
+        },
+        [this](const TourResult& tour) {
+            showTour(tour);
+        });
 }
 
-void MainWindow::resetScene() {
-    // 停止定时器（如果正在运行）
-    if (dfsTimer && dfsTimer->isActive()) {
+void MainWindow::showTour(const TourResult& tour) {
+    CAMPUS_PROFILE_SCOPE("scene.showTour");
+    if (!tour.found) {
+        ui->outputDisplay->setText("部分景点之间无法到达，无法规划游览路线！");
+        return;
+    }
+
+    QString tourStr = tour.exact ? "游览顺序（最优解）：\n" : "游览顺序（启发式）：\n";
+    for (size_t i = 0; i < tour.order.size(); ++i) {
+        tourStr += QString::fromStdString(graph.getVex(tour.order[i]).name);
+        if (i + 1 < tour.order.size()) {
+            tourStr += QString(" -(%1)-> ").arg(tour.legDistances[i], 0, 'f', 2);
+        }
+    }
+    tourStr += QString("\n总距离：%1").arg(tour.distance, 0, 'f', 2);
+    tourStr += QString("\n距离表耗时：%1 ms，求解耗时：%2 ms")
+                   .arg(tour.matrixMilliseconds, 0, 'f', 1)
+                   .arg(tour.solveMilliseconds, 0, 'f', 2);
+    ui->outputDisplay->setText(tourStr);
+
+    clearHighlights();
+    highlightPath(tour.path, QColor(255, 140, 0));
+}
+
+void MainWindow::stopDisplayTimer() {
+    if (dfsTimer) {
         dfsTimer->stop();
-        delete dfsTimer;
+        dfsTimer->deleteLater();
         dfsTimer = nullptr;
     }
+}
 
-    // 重置所有边的颜色
-    for (auto& edgePair : edgeItems) {
-        edgePair.second->setPen(QPen(Qt::gray, 2));
-    }
+void MainWindow::resetScene() {
+    // 取消后台查询，其结果不会再回到界面
+    queryExecutor->cancel();
+
+    // 停止定时器（如果正在运行）
+    stopDisplayTimer();
+
+    // 移除所有高亮
+    clearHighlights();
 
     isDfsRunning = false;
-    dfsPaths.clear();
+    dfsGenerator.reset();
+    alternativeRoutes.clear();
 }
 
 void MainWindow::on_importGraphButton_clicked() {
-    QString fileName = QFileDialog::getOpenFileName(this, "导入图数据", "", "文本文件 (*.txt);;所有文件 (*)");
+    CAMPUS_PROFILE_SCOPE("ui.import");
+    if (importWatcher->isRunning() || sceneBuildTimer->isActive()) {
+        return;
+    }
+    QString fileName = QFileDialog::getOpenFileName(this, "导入图数据", "", "文本文件 (*.txt);;图快照 (*.ctg);;所有文件 (*)");
     if (fileName.isEmpty()) {
         return;
     }
 
-    QFile file(fileName);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QMessageBox::warning(this, "错误", "无法打开文件！");
+    // 读取、解析和建图都在工作线程中完成，结果先放在独立的图中，
+    // 失败时当前地图保持不变
+    resetScene();
+    setImporting(true);
+    importStage->store(kImportReading);
+    importClock.start();
+    importProgressTimer->start();
+    updateImportProgress();
+
+    std::shared_ptr<std::atomic_int> stage = importStage;
+    importWatcher->setFuture(QtConcurrent::run([fileName, stage]() {
+        return loadGraphFile(fileName, stage);
+    }));
+}
+
+void MainWindow::updateImportProgress() {
+    QString seconds = QString::number(importClock.elapsed() / 1000.0, 'f', 1);
+    if (sceneBuildTimer->isActive()) {
+        size_t total = sceneVexs.size() + sceneEdges.size();
+        int percent = total ? static_cast<int>(sceneCursor * 100 / total) : 100;
+        statusBar()->showMessage(QString("正在构建场景... %1%（%2 秒）").arg(percent).arg(seconds));
         return;
     }
 
-    clearGraph();
+    switch (importStage->load()) {
+    case kImportReading:
+        statusBar()->showMessage(QString("正在读取文件...（%1 秒）").arg(seconds));
+        break;
+    case kImportParsing:
+        statusBar()->showMessage(QString("正在解析文件...（%1 秒）").arg(seconds));
+        break;
+    default:
+        statusBar()->showMessage(QString("正在构建图...（%1 秒）").arg(seconds));
+        break;
+    }
+}
 
-    QTextStream in(&file);
-    int nodeCount;
-    QString line = in.readLine();
-    bool ok;
-    nodeCount = line.trimmed().toInt(&ok);
-    if (!ok || nodeCount <= 0) {
-        QMessageBox::warning(this, "错误", "文件格式错误：节点数量无效！");
-        file.close();
+void MainWindow::onGraphImported() {
+    std::shared_ptr<ImportedGraph> result = importWatcher->result();
+    if (!result->error.empty()) {
+        importProgressTimer->stop();
+        statusBar()->clearMessage();
+        setImporting(false);
+        QMessageBox::warning(this, "错误", QString::fromStdString(result->error));
         return;
     }
 
-    // 读取节点信息
-    for (int i = 0; i < nodeCount; ++i) {
-        QString nodeName = in.readLine();
-        QString nodeInfo = in.readLine();
-        if (nodeName.isNull() || nodeInfo.isNull()) {
-            QMessageBox::warning(this, "错误", "文件格式错误：节点信息不足！");
-            file.close();
-            return;
-        }
-        nodeName = nodeName.trimmed();
-        nodeInfo = nodeInfo.trimmed();
-
-        // 添加节点到图结构
-        Vex newVex;
-        newVex.name = nodeName.toStdString();
-        newVex.introduction = nodeInfo.toStdString();
-        newVex.ticketInfo = "暂无门票信息";
-        int nodeId = graph.insertVex(newVex);
-
-        // 创建可拖动节点
-        DraggableEllipseItem* ellipse = new DraggableEllipseItem(nodeId, nodeName);
-        ellipse->setRect(-20, -20, 40, 40);
-
-        // 随机分配位置
-        QRectF sceneRect = scene->sceneRect();
-        static std::mt19937 generator(static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count()));
-        std::uniform_real_distribution<double> distributionX(sceneRect.left(), sceneRect.right());
-        std::uniform_real_distribution<double> distributionY(sceneRect.top(), sceneRect.bottom());
-        QPointF position(distributionX(generator), distributionY(generator));
-        ellipse->setPos(position);
-        ellipse->setBrush(Qt::green);
-        scene->addItem(ellipse);
-
-        // 插入到节点管理映射
-        nodeItems[nodeId] = ellipse;
-
-        // 绑定移动信号到槽函数
-        connect(ellipse, &DraggableEllipseItem::positionChanged, this, &MainWindow::on_sceneNodeMoved);
-    }
-
-    line = in.readLine();
-    int edgeCount = line.trimmed().toInt(&ok);
-    if (!ok || edgeCount < 0) {
-        QMessageBox::warning(this, "错误", "文件格式错误：边数量无效！");
-        file.close();
-        return;
-    }
-
-    // 读取边信息
-    for (int i = 0; i < edgeCount; ++i) {
-        QString line = in.readLine();
-        if (line.isNull()) {
-            QMessageBox::warning(this, "错误", "文件格式错误：边信息不足！");
-            file.close();
-            return;
-        }
-        QStringList parts = line.trimmed().split(" ");
-        if (parts.size() < 2) {
-            QMessageBox::warning(this, "错误", "文件格式错误：边格式不正确！");
-            file.close();
-            return;
-        }
+    clearGraph();
+    graph.replaceWith(std::move(result->graph));
+
+    QString summary = result->snapshot ? QString("快照加载完成：%1个节点，%2条边\n加载耗时：%3 ms")
+                                       : QString("导入完成：%1个节点，%2条边\n解析耗时：%3 ms\n建图耗时：%4 ms");
+    summary = summary.arg(graph.getCsrGraph()->size())
+                  .arg(graph.getCsrGraph()->neighbors.size() / 2)
+                  .arg(result->parseMs, 0, 'f', 2);
+    if (!result->snapshot) {
+        summary = summary.arg(result->buildMs, 0, 'f', 2);
+    }
+    populateScene(summary);
+}
 
-        QString startName = parts[0];
-        QString endName = parts[1];
+void MainWindow::setImporting(bool importing) {
+    // 场景未建完时节点图元不完整，编辑和查询都要等构建结束
+    centralWidget()->setEnabled(!importing);
+}
 
-        int startId = graph.getVexIndex(startName.toStdString());
-        int endId = graph.getVexIndex(endName.toStdString());
+void MainWindow::populateScene(const QString& summary) {
+    CAMPUS_PROFILE_SCOPE("scene.populate");
+    ui->graphView->setUpdatesEnabled(false);
+    scene->setItemIndexMethod(QGraphicsScene::NoIndex);
+
+    sceneVexs = graph.getAllVexs();
+    sceneEdges = graph.getAllEdges();
+    sceneCursor = 0;
+    sceneSummary = summary;
+    sceneClock.start();
+    if (!importClock.isValid()) {
+        importClock.start();
+    }
+    importProgressTimer->start();
 
-        if (startId == -1 || endId == -1) continue;
+    // 先创建节点再加入边，每批之间回到事件循环，界面保持响应
+    sceneBuildTimer->start(0);
+}
 
-        int minId = std::min(startId, endId);
-        int maxId = std::max(startId, endId);
+void MainWindow::buildSceneChunk() {
+    CAMPUS_PROFILE_SCOPE("scene.populateChunk");
+    size_t limit = sceneCursor + kSceneChunkSize;
+    size_t vexCount = sceneVexs.size();
+    size_t total = vexCount + sceneEdges.size();
+    for (; sceneCursor < limit && sceneCursor < total; ++sceneCursor) {
+        if (sceneCursor < vexCount) {
+            const Vex& vex = sceneVexs[sceneCursor];
+            createNodeItem(vex.num, QString::fromStdString(vex.name), QPointF(vex.x, vex.y));
+        } else {
+            const Edge& edge = sceneEdges[sceneCursor - vexCount];
+            QPointF pos1 = nodeItems[edge.vex1]->pos();
+            QPointF pos2 = nodeItems[edge.vex2]->pos();
+            edgeLayer->setEdge(edge.vex1, edge.vex2, pos1, pos2, edge.weight);
+        }
+    }
+    if (sceneCursor >= total) {
+        finishSceneBuild();
+    }
+}
 
-        QPointF pos1 = nodeItems[startId]->pos();
-        QPointF pos2 = nodeItems[endId]->pos();
-        double distance = calculateDistance(pos1, pos2);
+void MainWindow::finishSceneBuild() {
+    sceneBuildTimer->stop();
+    importProgressTimer->stop();
+    statusBar()->clearMessage();
+    double sceneMs = sceneClock.nsecsElapsed() / 1e6;
+    importClock.invalidate();
+    sceneVexs.clear();
+    sceneVexs.shrink_to_fit();
+    sceneEdges.clear();
+    sceneEdges.shrink_to_fit();
+
+    // 恢复BSP索引时整体重建一次，而不是每加入一个图元更新一次
+    scene->setItemIndexMethod(QGraphicsScene::BspTreeIndex);
+    ui->graphView->setUpdatesEnabled(true);
+
+    if (ui->liveMstCheckBox->isChecked()) {
+        rebuildLiveMst();
+    }
+    scheduleIndexRebuild();
+    setImporting(false);
 
-        // 添加到图数据结构中
-        graph.addEdge(minId, maxId, distance);
+    ui->outputDisplay->setText(sceneSummary + QString("\n场景构建耗时：%1 ms").arg(sceneMs, 0, 'f', 2));
+}
 
-        // 绘制边
-        QPen pen(Qt::gray);
-        pen.setWidth(2);
-        QGraphicsLineItem* lineItem = scene->addLine(QLineF(pos1, pos2), pen);
-        edgeItems[{minId, maxId}] = lineItem;
+DraggableEllipseItem* MainWindow::createNodeItem(int nodeId, const QString& name, const QPointF& position) {
+    DraggableEllipseItem* ellipse = new DraggableEllipseItem(nodeId, name);
+    ellipse->setRect(-20, -20, 40, 40);
+    ellipse->setPos(position);
+    ellipse->setBrush(Qt::green);
+    scene->addItem(ellipse);
 
-        // 显示边权重
-        QPointF midPoint = (pos1 + pos2) / 2;
-        QGraphicsTextItem* text = scene->addText(QString::number(distance, 'f', 2));
-        text->setDefaultTextColor(Qt::blue);
-        text->setPos(midPoint);
-        edgeWeightTexts[{minId, maxId}] = text;
-    }
+    // 插入到节点管理映射
+    nodeItems[nodeId] = ellipse;
 
-    file.close();
+    // 绑定移动信号到槽函数
+    connect(ellipse, &DraggableEllipseItem::positionChanged, this, &MainWindow::on_sceneNodeMoved);
+    connect(ellipse, &DraggableEllipseItem::positionChanging, this, &MainWindow::on_sceneNodeMoving);
+    return ellipse;
+}
+
+QPointF MainWindow::randomScenePosition() {
+    QRectF sceneRect = scene->sceneRect();
+    static std::mt19937 generator(static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count()));
+    std::uniform_real_distribution<double> distributionX(sceneRect.left(), sceneRect.right());
+    std::uniform_real_distribution<double> distributionY(sceneRect.top(), sceneRect.bottom());
+    return QPointF(distributionX(generator), distributionY(generator));
 }
 
 void MainWindow::on_exportGraphButton_clicked() {
-    QString fileName = QFileDialog::getSaveFileName(this, "导出图数据", "", "文本文件 (*.txt);;所有文件 (*)");
+    CAMPUS_PROFILE_SCOPE("ui.export");
+    QString fileName = QFileDialog::getSaveFileName(this, "导出图数据", "", "文本文件 (*.txt);;图快照 (*.ctg);;所有文件 (*)");
     if (fileName.isEmpty()) {
         return;
     }
 
+    // 按扩展名选择格式：.ctg 写出二进制快照（含坐标与权重）
+    if (fileName.endsWith(".ctg", Qt::CaseInsensitive)) {
+        // 先序列化，超出格式范围时不创建文件
+        std::string bytes;
+        std::string error;
+        if (!GraphSnapshot::serialize(graph, bytes, error)) {
+            QMessageBox::warning(this, "错误", QString::fromStdString(error));
+            return;
+        }
+        QFile snapshotFile(fileName);
+        if (!snapshotFile.open(QIODevice::WriteOnly)) {
+            QMessageBox::warning(this, "错误", "无法创建文件！");
+            return;
+        }
+        if (snapshotFile.write(bytes.data(), static_cast<qint64>(bytes.size())) != static_cast<qint64>(bytes.size())) {
+            QMessageBox::warning(this, "错误", "写入快照文件失败！");
+        }
+        snapshotFile.close();
+        return;
+    }
+
     QFile file(fileName);
     if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
         QMessageBox::warning(this, "错误", "无法创建文件！");
         return;
     }
 
-    QTextStream out(&file);
-
-    // 写入节点信息
-    auto allVexs = graph.getAllVexs();
-    out << allVexs.size() << "\n";
-    for (const auto& vex : allVexs) {
-        out << QString::fromStdString(vex.name) << "\n";
-        out << QString::fromStdString(vex.introduction) << "\n";
-    }
-
-    // 写入边信息
-    auto allEdges = graph.getAllEdges();
-    out << allEdges.size() << "\n";
-    for (const auto& edge : allEdges) {
-        out << QString::fromStdString(graph.getVex(edge.vex1).name) << " "
-            << QString::fromStdString(graph.getVex(edge.vex2).name) << "\n";
+    std::string text = GraphIO::writeText(graph);
+    if (file.write(text.data(), static_cast<qint64>(text.size())) == -1) {
+        QMessageBox::warning(this, "错误", "写入文件失败！");
     }
 
     file.close();
 }
 
 void MainWindow::clearGraph() {
-    // 清除场景中的所有项目
+    resetScene();
+
+    // 清除场景中的所有项目（边图层随之删除，需重新创建）
     scene->clear();
+    highlightItems.clear();
+    liveMstItems.clear();
+    liveMst.clear();
+    edgeLayer = new EdgeLayerItem();
+    scene->addItem(edgeLayer);
 
     // 清空数据结构
     nodeItems.clear();
-    edgeItems.clear();
-    edgeWeightTexts.clear();
+    dirtyNodes.clear();
     graph.clearGraph();
+    scheduleIndexRebuild();
+}
+
+void MainWindow::on_chCheckBox_toggled(bool checked) {
+    if (checked) {
+        rebuildRouteIndex();
+    } else {
+        chIndex.reset();
+    }
+}
+
+void MainWindow::on_liveMstCheckBox_toggled(bool checked) {
+    if (checked) {
+        rebuildLiveMst();
+        return;
+    }
+
+    for (auto& pair : liveMstItems) {
+        scene->removeItem(pair.second);
+        delete pair.second;
+    }
+    liveMstItems.clear();
+    liveMst.clear();
+    statusBar()->clearMessage();
+}
+
+void MainWindow::rebuildLiveMst() {
+    CAMPUS_PROFILE_SCOPE("mst.liveRebuild");
+    for (auto& pair : liveMstItems) {
+        scene->removeItem(pair.second);
+        delete pair.second;
+    }
+    liveMstItems.clear();
+
+    liveMst.build(graph.getAllEdges());
+    applyLiveMstChanges();
+}
+
+void MainWindow::applyLiveMstChanges() {
+    CAMPUS_PROFILE_SCOPE("scene.liveMst");
+    for (const auto& change : liveMst.takeChanges()) {
+        auto edgeKey = std::make_pair(change.v1, change.v2);
+        auto it = liveMstItems.find(edgeKey);
+        if (change.added && it == liveMstItems.end()) {
+            QLineF line(nodeItems[change.v1]->pos(), nodeItems[change.v2]->pos());
+            QGraphicsLineItem* item = scene->addLine(line, QPen(Qt::green, 3));
+            item->setZValue(-0.75); // 位于普通边之上、查询高亮之下
+            liveMstItems[edgeKey] = item;
+        } else if (!change.added && it != liveMstItems.end()) {
+            scene->removeItem(it->second);
+            delete it->second;
+            liveMstItems.erase(it);
+        }
+    }
+    statusBar()->showMessage(QString("实时最小生成树总权重：%1").arg(liveMst.totalWeight(), 0, 'f', 2));
+}
+
+void MainWindow::scheduleIndexRebuild() {
+    if (ui->chCheckBox->isChecked() || ui->apspCheckBox->isChecked()) {
+        indexRebuildTimer->start();
+    }
+}
+
+void MainWindow::rebuildRouteIndex() {
+    rebuildDistanceMatrix();
+
+    if (!ui->chCheckBox->isChecked() || chWatcher->isRunning()) {
+        // 正在构建时，完成后会再检查快照是否过期
+        return;
+    }
+
+    auto csr = graph.getCsrGraph();
+    if (chIndex && chIndex->isBuiltFor(csr.get())) {
+        return;
+    }
+
+    statusBar()->showMessage("正在后台构建CH索引...");
+    chWatcher->setFuture(QtConcurrent::run([csr]() {
+        return std::make_shared<ContractionHierarchy>(csr);
+    }));
+}
+
+void MainWindow::onRouteIndexBuilt() {
+    if (!ui->chCheckBox->isChecked()) {
+        return;
+    }
+
+    chIndex = chWatcher->result();
+    statusBar()->showMessage(QString("CH索引构建完成，捷径数：%1").arg(chIndex->shortcutCount()), 5000);
+
+    // 构建期间图又被编辑过，则继续重建
+    if (!chIndex->isBuiltFor(graph.getCsrGraph().get())) {
+        scheduleIndexRebuild();
+    }
+}
+
+void MainWindow::on_apspCheckBox_toggled(bool checked) {
+    if (checked) {
+        rebuildDistanceMatrix();
+    } else {
+        distanceMatrix.reset();
+    }
+}
+
+void MainWindow::rebuildDistanceMatrix() {
+    if (!ui->apspCheckBox->isChecked() || matrixWatcher->isRunning()) {
+        // 正在构建时，完成后会再检查边版本是否过期
+        return;
+    }
+
+    // 只有边或权重变化才需要重建，单纯增删孤立节点或移动坐标不影响距离
+    std::uint64_t version = graph.edgeVersion();
+    if (distanceMatrix && distanceMatrix->edgeVersion() == version) {
+        return;
+    }
+
+    auto csr = graph.getCsrGraph();
+    if (csr->size() > DistanceMatrix::kMaxVertices) {
+        distanceMatrix.reset();
+        statusBar()->showMessage(QString("节点数超过%1（需约%2 MB），不构建距离矩阵")
+                                     .arg(DistanceMatrix::kMaxVertices)
+                                     .arg(DistanceMatrix::estimateBytes(csr->size()) / (1024.0 * 1024.0), 0, 'f', 1),
+                                 5000);
+        return;
+    }
+
+    statusBar()->showMessage("正在后台构建距离矩阵...");
+    matrixWatcher->setFuture(QtConcurrent::run([csr, version]() {
+        return std::make_shared<DistanceMatrix>(csr, version);
+    }));
+}
+
+void MainWindow::onDistanceMatrixBuilt() {
+    if (!ui->apspCheckBox->isChecked()) {
+        return;
+    }
+
+    distanceMatrix = matrixWatcher->result();
+    statusBar()->showMessage(QString("距离矩阵构建完成：%1个节点，占用%2 MB，耗时%3 ms")
+                                 .arg(graph.getCsrGraph()->size())
+                                 .arg(distanceMatrix->memoryBytes() / (1024.0 * 1024.0), 0, 'f', 1)
+                                 .arg(distanceMatrix->buildMilliseconds(), 0, 'f', 1),
+                             5000);
+
+    // 构建期间边又被修改过，则继续重建
+    if (distanceMatrix->edgeVersion() != graph.edgeVersion()) {
+        scheduleIndexRebuild();
+    }
+}
+
+void MainWindow::on_statsButton_clicked() {
+    statsPanel->setVisible(!statsPanel->isVisible());
 }
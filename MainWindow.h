@@ -4,10 +4,23 @@
 #include <QMainWindow>
 #include <QGraphicsScene>
 #include <QGraphicsEllipseItem>
+#include <QColor>
+#include <QStaticText>
 #include <QWidget>
 #include <QLabel>
 #include <QGridLayout>
 #include "Graph.h"
+#include "ContractionHierarchy.h"
+#include "DistanceMatrix.h"
+#include "RouteCache.h"
+#include "MstEngine.h"
+#include "TourPlanner.h"
+#include "DynamicMst.h"
+#include "DfsPathGenerator.h"
+#include "KShortestPaths.h"
+#include "QueryExecutor.h"
+#include "EdgeLayerItem.h"
+#include "StatsPanel.h"
 
 #include <QPushButton>
 #include <QLineEdit>
@@ -19,6 +32,20 @@
 #include <QFile>
 #include <QTextStream>
 #include <QIntValidator>
+#include <QFutureWatcher>
+#include <QElapsedTimer>
+#include <atomic>
+#include <memory>
+#include <set>
+
+// 后台导入的结果：图模型在工作线程中建好，界面线程只负责替换图并分批构建场景
+struct ImportedGraph {
+    Graph graph;
+    std::string error;                           // 非空表示导入失败
+    bool snapshot = false;                       // 是否为二进制快照
+    double parseMs = 0.0;                        // 读取与解析的耗时（快照为整个加载的耗时）
+    double buildMs = 0.0;                        // 由解析结果建图的耗时（快照为 0）
+};
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
@@ -32,18 +59,24 @@ public:
     int getNodeId() const;
     void updateLabelPosition();
 
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
+
 signals:
-    void positionChanged();
+    void positionChanged(int nodeId);            // 拖动结束
+    void positionChanging(int nodeId);           // 位置变化（含多选拖动中被一起移动）
 
 protected:
     void mouseMoveEvent(QGraphicsSceneMouseEvent* event) override;
     void mouseReleaseEvent(QGraphicsSceneMouseEvent* event) override;
+    QVariant itemChange(GraphicsItemChange change, const QVariant& value) override;
 
 private:
     int nodeId;
     bool moved;
     QPointF originalPosition;
-    QGraphicsTextItem* label;
+    QStaticText label;       // 预先排版的标签文字，绘制时不再重新布局
+    QPointF labelOffset;     // 标签左上角相对节点中心的位置
 };
 
 class MainWindow : public QMainWindow {
@@ -59,12 +92,28 @@ private slots:
     void on_addEdgeButton_clicked();
     void on_deleteEdgeButton_clicked();
     void on_nodeSelected();
-    void on_sceneNodeMoved();
+    void on_sceneNodeMoved(int nodeId);
+    void on_sceneNodeMoving(int nodeId);
+    void flushDirtyEdges();
     void on_findShortestPathButton_clicked();
     void on_dfsButton_clicked();
+    void on_kPathsButton_clicked();
     void on_mstButton_clicked();
+    void on_tourButton_clicked();
     void on_importGraphButton_clicked();
     void on_exportGraphButton_clicked();
+    void onGraphImported();
+    void updateImportProgress();
+    void buildSceneChunk();
+    void on_chCheckBox_toggled(bool checked);
+    void on_liveMstCheckBox_toggled(bool checked);
+    void rebuildRouteIndex();
+    void onRouteIndexBuilt();
+    void on_apspCheckBox_toggled(bool checked);
+    void onDistanceMatrixBuilt();
+    void on_statsButton_clicked();
+    void advanceDfsPath();
+    void advanceAlternativeRoute();
 
 private:
     Ui::MainWindow* ui;
@@ -72,17 +121,75 @@ private:
     QGraphicsScene* scene;
 
     std::map<int, DraggableEllipseItem*> nodeItems;
-    std::map<std::pair<int, int>, QGraphicsLineItem*> edgeItems;
-    std::map<std::pair<int, int>, QGraphicsTextItem*> edgeWeightTexts;
+    EdgeLayerItem* edgeLayer;                    // 批量绘制所有普通边及权重
+    std::map<std::pair<int, int>, QGraphicsLineItem*> highlightItems; // 高亮路径的覆盖线段
+
+    // 拖动中位置发生变化的节点，每帧最多统一刷新一次相连的边
+    std::set<int> dirtyNodes;
+    QTimer* edgeFlushTimer;
 
     QTimer* dfsTimer;
-    int dfsPathIndex;
     bool isDfsRunning;
-    std::vector<std::vector<int>> dfsPaths;
+    std::shared_ptr<DfsPathGenerator> dfsGenerator;
+    std::vector<RouteResult> alternativeRoutes; // 前 k 条最短路线，由 dfsTimer 轮流展示
+    size_t alternativeIndex;
+    void stopDisplayTimer();                     // 停止并释放轮流展示用的定时器
     void resetScene();
 
+    // 收缩层次索引（图被编辑后在后台重建）
+    std::shared_ptr<ContractionHierarchy> chIndex;
+    QFutureWatcher<std::shared_ptr<ContractionHierarchy>>* chWatcher;
+
+    // 全源距离矩阵（只在边或权重变化后在后台重建）
+    std::shared_ptr<DistanceMatrix> distanceMatrix;
+    QFutureWatcher<std::shared_ptr<DistanceMatrix>>* matrixWatcher;
+    void rebuildDistanceMatrix();
+    QTimer* indexRebuildTimer;
+    void scheduleIndexRebuild();
+
+    // 后台查询执行器（新查询会取消正在执行的旧查询）
+    QueryExecutor* queryExecutor;
+    void showRoute(const RouteResult& route, const QString& detail);
+
+    // 最短路径结果缓存（图被修改后自动作废），命中统计显示在状态栏
+    RouteCache routeCache;
+    QLabel* cacheStatusLabel;
+    void updateCacheStatus();
+    void showMst(const MstResult& mst);
+    void showTour(const TourResult& tour);
+
+    // 性能统计面板（停靠在右侧，默认隐藏）
+    StatsPanel* statsPanel;
+
+    // 实时最小生成树：随边的增删和拖动增量维护，覆盖层独立于查询高亮
+    DynamicMst liveMst;
+    std::map<std::pair<int, int>, QGraphicsLineItem*> liveMstItems;
+    void rebuildLiveMst();                       // 按当前图重建实时最小生成树
+    void applyLiveMstChanges();                  // 把树边的增减同步到覆盖层
+
     void updateEdges();
+    void updateEdgeGeometry(int id1, int id2);   // 按节点当前位置更新一条边的线段、权重和标签
+    void highlightEdge(int v1, int v2, const QColor& color); // 在边上叠加高亮线段
+    void highlightPath(const std::vector<int>& path, const QColor& color); // 高亮路径上的所有边
+    void clearHighlights();                      // 移除所有高亮
     double calculateDistance(const QPointF& p1, const QPointF& p2);
+    DraggableEllipseItem* createNodeItem(int nodeId, const QString& name, const QPointF& position); // 创建节点图元
+    QPointF randomScenePosition();               // 在地图范围内随机取一个位置
+    void populateScene(const QString& summary);  // 按图模型分批构建场景，完成后显示 summary
+    void finishSceneBuild();                     // 场景构建完成：恢复索引与刷新并重新启用界面
+    void setImporting(bool importing);           // 导入期间禁用编辑和查询
+
+    // 后台导入与分批构建场景
+    QFutureWatcher<std::shared_ptr<ImportedGraph>>* importWatcher;
+    std::shared_ptr<std::atomic_int> importStage; // 工作线程当前所处的阶段
+    QTimer* importProgressTimer;
+    QElapsedTimer importClock;                   // 整个导入的计时，用于进度显示
+    QElapsedTimer sceneClock;                    // 分批构建场景的计时
+    QTimer* sceneBuildTimer;
+    std::vector<Vex> sceneVexs;                  // 待创建图元的节点
+    std::vector<Edge> sceneEdges;                // 待加入边图层的边
+    size_t sceneCursor;                          // 已处理的节点与边总数
+    QString sceneSummary;
     void clearGraph();
 };
 
@@ -0,0 +1,202 @@
+#include "MstEngine.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <numeric>
+#include <thread>
+
+namespace {
+const int kCancelCheckInterval = 4096;  // 每处理多少条边检查一次取消标志
+}
+
+DisjointSet::DisjointSet(int size) {
+    reset(size);
+}
+
+void DisjointSet::reset(int size) {
+    parent.resize(size);
+    std::iota(parent.begin(), parent.end(), 0);
+    rank.assign(size, 0);
+}
+
+int DisjointSet::find(int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+bool DisjointSet::unite(int a, int b) {
+    a = find(a);
+    b = find(b);
+    if (a == b) {
+        return false;
+    }
+    if (rank[a] < rank[b]) {
+        std::swap(a, b);
+    }
+    parent[b] = a;
+    if (rank[a] == rank[b]) {
+        ++rank[a];
+    }
+    return true;
+}
+
+MstEngine::MstEngine(std::shared_ptr<const CsrGraph> graph)
+    : graph(std::move(graph)), cancelFlag(nullptr) {
+    // 每条无向边在CSR中出现两次，只保留 u < v 的一半并编号
+    const CsrGraph& g = *this->graph;
+    int m = static_cast<int>(g.neighbors.size()) / 2;
+    sources.reserve(m);
+    targets.reserve(m);
+    weights.reserve(m);
+    for (int u = 0; u < g.size(); ++u) {
+        for (int e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+            if (u < g.neighbors[e]) {
+                sources.push_back(u);
+                targets.push_back(g.neighbors[e]);
+                weights.push_back(g.weights[e]);
+            }
+        }
+    }
+}
+
+void MstEngine::setCancelFlag(const std::atomic_bool* flag) {
+    cancelFlag = flag;
+}
+
+bool MstEngine::isCancelled() const {
+    return cancelFlag && cancelFlag->load(std::memory_order_relaxed);
+}
+
+MstResult MstEngine::finish(std::vector<int>& edgeIds, bool cancelled) const {
+    MstResult result;
+    if (cancelled) {
+        result.cancelled = true;
+        return result;
+    }
+
+    std::sort(edgeIds.begin(), edgeIds.end(), [this](int a, int b) {
+        return weights[a] != weights[b] ? weights[a] < weights[b] : a < b;
+    });
+    result.edges.reserve(edgeIds.size());
+    for (int id : edgeIds) {
+        result.edges.push_back({graph->vexNum(sources[id]), graph->vexNum(targets[id]), weights[id]});
+        result.totalWeight += weights[id];
+    }
+    result.componentCount = graph->size() - static_cast<int>(edgeIds.size());
+    return result;
+}
+
+MstResult MstEngine::kruskal() {
+    CAMPUS_PROFILE_SCOPE("mst.kruskal");
+    int m = static_cast<int>(weights.size());
+    std::vector<int> order(m);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](int a, int b) {
+        return weights[a] != weights[b] ? weights[a] < weights[b] : a < b;
+    });
+
+    DisjointSet sets(graph->size());
+    std::vector<int> chosen;
+    int target = graph->size() - 1;
+    for (int i = 0; i < m && static_cast<int>(chosen.size()) < target; ++i) {
+        if (i % kCancelCheckInterval == 0 && isCancelled()) {
+            return finish(chosen, true);
+        }
+        int id = order[i];
+        if (sets.unite(sources[id], targets[id])) {
+            chosen.push_back(id);
+        }
+    }
+    return finish(chosen, false);
+}
+
+MstResult MstEngine::boruvka(int threadCount) {
+    CAMPUS_PROFILE_SCOPE("mst.boruvka");
+    int n = graph->size();
+    int m = static_cast<int>(weights.size());
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    DisjointSet sets(n);
+    std::vector<int> component(n);
+    std::iota(component.begin(), component.end(), 0);
+    std::vector<std::atomic<int>> cheapest(n); // 分量代表元 -> 最轻出边号（-1 表示无）
+    std::vector<int> active(m);                // 仍连接两个不同分量的边
+    std::iota(active.begin(), active.end(), 0);
+    std::vector<int> chosen;
+
+    // 边的全序：先比权重，再比边号，保证权重相同时也不会成环
+    auto lighter = [this](int a, int b) {
+        return b == -1 || weights[a] < weights[b] || (weights[a] == weights[b] && a < b);
+    };
+
+    // 用比较交换把边号写入分量的最轻出边
+    auto offer = [&](int c, int id) {
+        int current = cheapest[c].load(std::memory_order_relaxed);
+        while (lighter(id, current)) {
+            if (cheapest[c].compare_exchange_weak(current, id, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+    };
+
+    // 每个工作线程扫描一段连续的活动边
+    auto scan = [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            int id = active[i];
+            int cu = component[sources[id]];
+            int cv = component[targets[id]];
+            if (cu != cv) {
+                offer(cu, id);
+                offer(cv, id);
+            }
+        }
+    };
+
+    while (!active.empty()) {
+        if (isCancelled()) {
+            return finish(chosen, true);
+        }
+        for (auto& slot : cheapest) {
+            slot.store(-1, std::memory_order_relaxed);
+        }
+
+        // 并行：每个分量找出最轻的出边（边数较少时不值得开线程）
+        int count = static_cast<int>(active.size());
+        int workerCount = std::max(1, std::min(threadCount, count / kCancelCheckInterval));
+        int chunk = (count + workerCount - 1) / workerCount;
+        std::vector<std::thread> workers;
+        for (int t = 1; t < workerCount; ++t) {
+            workers.emplace_back(scan, std::min(count, t * chunk), std::min(count, (t + 1) * chunk));
+        }
+        scan(0, std::min(count, chunk));
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        // 串行：合并各分量与其最轻出边另一端的分量
+        bool merged = false;
+        for (int c = 0; c < n; ++c) {
+            int id = cheapest[c].load(std::memory_order_relaxed);
+            if (id != -1 && sets.unite(sources[id], targets[id])) {
+                chosen.push_back(id);
+                merged = true;
+            }
+        }
+        if (!merged) {
+            break;
+        }
+
+        // 刷新分量编号并丢弃已落在同一分量内的边
+        for (int u = 0; u < n; ++u) {
+            component[u] = sets.find(u);
+        }
+        active.erase(std::remove_if(active.begin(), active.end(), [&](int id) {
+            return component[sources[id]] == component[targets[id]];
+        }), active.end());
+    }
+    return finish(chosen, false);
+}
@@ -0,0 +1,51 @@
+#ifndef MSTENGINE_H
+#define MSTENGINE_H
+
+#include "Graph.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// 基于数组的并查集（按秩合并 + 路径减半，不使用递归）
+class DisjointSet {
+public:
+    explicit DisjointSet(int size = 0);      // 构造函数
+    void reset(int size);                    // 重置为 size 个单元素集合
+    int find(int x);                         // 查找代表元
+    bool unite(int a, int b);                // 合并两个集合，已在同一集合时返回 false
+
+private:
+    std::vector<int> parent;
+    std::vector<unsigned char> rank;
+};
+
+// 最小生成森林的计算结果
+struct MstResult {
+    std::vector<Edge> edges;                 // 森林中的边（端点为节点编号）
+    double totalWeight = 0.0;                // 总权重
+    int componentCount = 0;                  // 连通分量个数（为 1 时是一棵生成树）
+    bool cancelled = false;                  // 是否被取消
+};
+
+// 与界面无关的最小生成树引擎，在不可变的CSR快照上运行
+// 图不连通时返回最小生成森林
+class MstEngine {
+public:
+    explicit MstEngine(std::shared_ptr<const CsrGraph> graph); // 构造函数
+
+    MstResult kruskal();                     // 串行 Kruskal
+    MstResult boruvka(int threadCount = 0);  // 多线程 Borůvka（0 表示使用全部硬件线程）
+    void setCancelFlag(const std::atomic_bool* flag); // 设置取消标志
+
+private:
+    bool isCancelled() const;
+    MstResult finish(std::vector<int>& edgeIds, bool cancelled) const; // 由边号生成结果
+
+    std::shared_ptr<const CsrGraph> graph;   // 邻接快照
+    const std::atomic_bool* cancelFlag;      // 取消标志（可为空）
+    std::vector<int> sources;                // 边号 -> 较小端点的稠密下标
+    std::vector<int> targets;                // 边号 -> 较大端点的稠密下标
+    std::vector<double> weights;             // 边号 -> 权重
+};
+
+#endif // MSTENGINE_H
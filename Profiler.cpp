@@ -0,0 +1,175 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <thread>
+
+std::atomic_bool Profiler::enabledFlag(false);
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler() : origin(Clock::now()), traceNext(0) {}
+
+void Profiler::setEnabled(bool enabled) {
+    enabledFlag.store(enabled, std::memory_order_relaxed);
+}
+
+int Profiler::bucketOf(std::uint64_t ns) {
+    if (ns < 8) {
+        return static_cast<int>(ns);
+    }
+    int exponent = 63;
+    while (!(ns >> exponent)) {
+        --exponent;
+    }
+    int mantissa = static_cast<int>((ns >> (exponent - 3)) & 7);
+    return std::min(kBucketCount - 1, 8 * (exponent - 2) + mantissa);
+}
+
+double Profiler::bucketMidpoint(int bucket) {
+    if (bucket < 8) {
+        return bucket;
+    }
+    int exponent = bucket / 8 + 2;
+    int mantissa = bucket % 8;
+    double width = static_cast<double>(1ULL << (exponent - 3));
+    return (8 + mantissa + 0.5) * width;
+}
+
+void Profiler::Histogram::add(std::uint64_t ns) {
+    ++buckets[bucketOf(ns)];
+    ++count;
+    totalNs += ns;
+    minNs = std::min(minNs, ns);
+    maxNs = std::max(maxNs, ns);
+}
+
+double Profiler::Histogram::percentile(double q) const {
+    if (count == 0) {
+        return 0.0;
+    }
+    std::uint64_t rank = static_cast<std::uint64_t>(q * (count - 1)) + 1;
+    std::uint64_t seen = 0;
+    for (int b = 0; b < kBucketCount; ++b) {
+        seen += buckets[b];
+        if (seen >= rank) {
+            return std::clamp(bucketMidpoint(b), static_cast<double>(minNs), static_cast<double>(maxNs));
+        }
+    }
+    return static_cast<double>(maxNs);
+}
+
+int Profiler::threadIndex() {
+    std::size_t key = std::hash<std::thread::id>()(std::this_thread::get_id());
+    auto it = threadIds.find(key);
+    if (it == threadIds.end()) {
+        it = threadIds.emplace(key, static_cast<int>(threadIds.size()) + 1).first;
+    }
+    return it->second;
+}
+
+void Profiler::record(const char* name, Clock::time_point start, Clock::time_point end) {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    std::lock_guard<std::mutex> lock(mutex);
+    histograms[name].add(static_cast<std::uint64_t>(std::max<long long>(0, ns)));
+
+    TraceEvent event;
+    event.name = name;
+    event.startUs = std::chrono::duration_cast<std::chrono::microseconds>(start - origin).count();
+    event.durationUs = ns / 1000;
+    event.thread = threadIndex();
+    if (trace.size() < kTraceCapacity) {
+        trace.push_back(event);
+    } else {
+        trace[traceNext] = event;
+    }
+    traceNext = (traceNext + 1) % kTraceCapacity;
+}
+
+void Profiler::count(const char* name, long long delta) {
+    if (!isEnabled()) {
+        return;
+    }
+    Profiler& profiler = instance();
+    std::lock_guard<std::mutex> lock(profiler.mutex);
+    profiler.counterValues[name] += delta;
+}
+
+void Profiler::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    histograms.clear();
+    counterValues.clear();
+    trace.clear();
+    traceNext = 0;
+    origin = Clock::now();
+}
+
+std::vector<Profiler::Stats> Profiler::statistics() const {
+    std::vector<Stats> result;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& pair : histograms) {
+            const Histogram& h = pair.second;
+            Stats stats;
+            stats.name = pair.first;
+            stats.count = h.count;
+            stats.totalUs = h.totalNs / 1000.0;
+            stats.meanUs = h.count ? stats.totalUs / h.count : 0.0;
+            stats.p50Us = h.percentile(0.50) / 1000.0;
+            stats.p95Us = h.percentile(0.95) / 1000.0;
+            stats.p99Us = h.percentile(0.99) / 1000.0;
+            stats.maxUs = h.maxNs / 1000.0;
+            result.push_back(std::move(stats));
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const Stats& a, const Stats& b) {
+        return a.totalUs > b.totalUs;
+    });
+    return result;
+}
+
+std::vector<Profiler::Counter> Profiler::counters() const {
+    std::vector<Counter> result;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& pair : counterValues) {
+            result.push_back({pair.first, pair.second});
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const Counter& a, const Counter& b) {
+        return a.name < b.name;
+    });
+    return result;
+}
+
+std::string Profiler::chromeTrace() const {
+    std::vector<TraceEvent> events;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // 环形缓冲区已满时从最旧的事件开始
+        if (trace.size() == kTraceCapacity) {
+            events.assign(trace.begin() + traceNext, trace.end());
+            events.insert(events.end(), trace.begin(), trace.begin() + traceNext);
+        } else {
+            events = trace;
+        }
+    }
+
+    std::ostringstream out;
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (size_t i = 0; i < events.size(); ++i) {
+        const TraceEvent& e = events[i];
+        out << (i ? ",\n" : "\n") << "{\"name\":\"";
+        for (const char* c = e.name; *c; ++c) {
+            if (*c == '"' || *c == '\\') out << '\\';
+            out << *c;
+        }
+        out << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.thread
+            << ",\"ts\":" << e.startUs << ",\"dur\":" << e.durationUs << "}";
+    }
+    out << "\n]}\n";
+    return out.str();
+}
@@ -0,0 +1,114 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 轻量的性能采集
+// 用 CAMPUS_PROFILE_SCOPE("名称") 统计一段作用域的耗时，用 Profiler::count() 累加计数器。
+// 关闭时每个作用域只有一次原子读；开启后按名称维护对数分桶直方图（可估算 p50/p95/p99），
+// 并在环形缓冲区中保留最近的事件，可导出为 Chrome trace-event JSON
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // 单个名称的耗时统计（单位：微秒）
+    struct Stats {
+        std::string name;
+        std::uint64_t count = 0;
+        double totalUs = 0.0;
+        double meanUs = 0.0;
+        double p50Us = 0.0;
+        double p95Us = 0.0;
+        double p99Us = 0.0;
+        double maxUs = 0.0;
+    };
+
+    struct Counter {
+        std::string name;
+        long long value = 0;
+    };
+
+    static Profiler& instance();             // 全局实例
+    static bool isEnabled() { return enabledFlag.load(std::memory_order_relaxed); }
+    void setEnabled(bool enabled);           // 开启或关闭采集
+
+    void record(const char* name, Clock::time_point start, Clock::time_point end); // 记录一次耗时
+    static void count(const char* name, long long delta = 1); // 累加计数器（关闭时不做任何事）
+    void reset();                            // 清空所有统计与事件
+
+    std::vector<Stats> statistics() const;   // 按总耗时降序的统计
+    std::vector<Counter> counters() const;   // 按名称排序的计数器
+    std::string chromeTrace() const;         // 最近的事件，Chrome trace-event JSON（chrome://tracing 或 Perfetto 可打开）
+
+private:
+    static const int kBucketCount = 512;
+    static const size_t kTraceCapacity = 100000; // 保留的事件数上限
+
+    // 对数分桶直方图：每个 2 的幂区间再分 8 个子桶，相对误差约 6%
+    struct Histogram {
+        std::vector<std::uint64_t> buckets = std::vector<std::uint64_t>(kBucketCount, 0);
+        std::uint64_t count = 0;
+        std::uint64_t totalNs = 0;
+        std::uint64_t minNs = UINT64_MAX;
+        std::uint64_t maxNs = 0;
+
+        void add(std::uint64_t ns);
+        double percentile(double q) const;   // 返回纳秒
+    };
+
+    struct TraceEvent {
+        const char* name;
+        std::int64_t startUs;                // 相对 origin 的起始时间
+        std::int64_t durationUs;
+        int thread;
+    };
+
+    Profiler();
+    static int bucketOf(std::uint64_t ns);
+    static double bucketMidpoint(int bucket);
+    int threadIndex();                       // 调用线程的编号（调用方持有锁）
+
+    static std::atomic_bool enabledFlag;
+    mutable std::mutex mutex;
+    Clock::time_point origin;
+    std::unordered_map<std::string, Histogram> histograms;
+    std::unordered_map<std::string, long long> counterValues;
+    std::vector<TraceEvent> trace;           // 环形缓冲区
+    size_t traceNext;
+    std::unordered_map<std::size_t, int> threadIds;
+};
+
+// 统计所在作用域的耗时；构造时未开启采集则析构时也不记录
+// 事件只保存名称指针，名称应当是字符串字面量
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name)
+        : name(Profiler::isEnabled() ? name : nullptr) {
+        if (this->name) {
+            start = Profiler::Clock::now();
+        }
+    }
+    ~ProfileScope() {
+        if (name) {
+            Profiler::instance().record(name, start, Profiler::Clock::now());
+        }
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    Profiler::Clock::time_point start;
+};
+
+#define CAMPUS_PROFILE_CONCAT_INNER(a, b) a##b
+#define CAMPUS_PROFILE_CONCAT(a, b) CAMPUS_PROFILE_CONCAT_INNER(a, b)
+#define CAMPUS_PROFILE_SCOPE(name) ProfileScope CAMPUS_PROFILE_CONCAT(profileScope, __LINE__)(name)
+
+#endif // PROFILER_H
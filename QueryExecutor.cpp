@@ -0,0 +1,30 @@
+#include "QueryExecutor.h"
+
+QueryExecutor::QueryExecutor(QObject* parent)
+    : QObject(parent), generation(0), busy(false) {}
+
+QueryExecutor::~QueryExecutor() {
+    // 正在运行的任务持有各自的取消标志副本，这里只需通知其退出
+    if (cancelFlag) {
+        cancelFlag->store(true);
+    }
+}
+
+void QueryExecutor::cancel() {
+    if (cancelFlag) {
+        cancelFlag->store(true);
+        cancelFlag.reset();
+    }
+    setBusy(false);
+}
+
+bool QueryExecutor::isBusy() const {
+    return busy;
+}
+
+void QueryExecutor::setBusy(bool value) {
+    if (busy != value) {
+        busy = value;
+        emit busyChanged(busy);
+    }
+}
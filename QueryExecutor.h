@@ -0,0 +1,63 @@
+#ifndef QUERYEXECUTOR_H
+#define QUERYEXECUTOR_H
+
+#include <QObject>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+// 后台查询执行器
+// 算法在线程池中运行，结果通过信号回到界面线程；同一时刻只保留一个有效查询，
+// 提交新查询或调用 cancel() 会通知旧查询尽快退出，并丢弃它的结果
+class QueryExecutor : public QObject {
+    Q_OBJECT
+public:
+    explicit QueryExecutor(QObject* parent = nullptr);
+    ~QueryExecutor();
+
+    // 提交查询：job 在工作线程运行并应定期检查取消标志，onFinished 在界面线程调用
+    template <typename Result>
+    void submit(std::function<Result(const std::atomic_bool&)> job,
+                std::function<void(const Result&)> onFinished);
+
+    void cancel();                               // 取消当前查询
+    bool isBusy() const;                         // 是否有尚未返回的有效查询
+
+signals:
+    void busyChanged(bool busy);                 // 有效查询开始或结束
+
+private:
+    void setBusy(bool value);
+
+    quint64 generation;                          // 查询代号，用于识别过期结果
+    std::shared_ptr<std::atomic_bool> cancelFlag; // 当前查询的取消标志
+    bool busy;
+};
+
+template <typename Result>
+void QueryExecutor::submit(std::function<Result(const std::atomic_bool&)> job,
+                           std::function<void(const Result&)> onFinished) {
+    cancel();
+
+    auto flag = std::make_shared<std::atomic_bool>(false);
+    cancelFlag = flag;
+    quint64 ticket = ++generation;
+    setBusy(true);
+
+    auto* watcher = new QFutureWatcher<Result>(this);
+    connect(watcher, &QFutureWatcher<Result>::finished, this, [this, watcher, flag, ticket, onFinished]() {
+        watcher->deleteLater();
+        if (ticket != generation || flag->load()) {
+            return; // 已被取消或被更新的查询取代
+        }
+        setBusy(false);
+        onFinished(watcher->result());
+    });
+    watcher->setFuture(QtConcurrent::run([job, flag]() {
+        return job(*flag);
+    }));
+}
+
+#endif // QUERYEXECUTOR_H
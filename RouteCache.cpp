@@ -0,0 +1,80 @@
+#include "RouteCache.h"
+
+RouteCache::RouteCache(std::size_t capacity)
+    : maxEntries(capacity > 0 ? capacity : 1), currentVersion(0), hitCount(0), missCount(0) {}
+
+std::uint64_t RouteCache::packKey(int src, int dst) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(src)) << 32) | static_cast<std::uint32_t>(dst);
+}
+
+bool RouteCache::adoptVersion(std::uint64_t version) {
+    if (version < currentVersion) {
+        return false;
+    }
+    if (version > currentVersion) {
+        clear();
+        currentVersion = version;
+    }
+    return true;
+}
+
+bool RouteCache::lookup(int src, int dst, std::uint64_t version, RouteResult& result) {
+    if (!adoptVersion(version)) {
+        ++missCount;
+        return false;
+    }
+
+    auto it = index.find(packKey(src, dst));
+    if (it == index.end()) {
+        ++missCount;
+        return false;
+    }
+
+    // 移到表头，标记为最近使用
+    entries.splice(entries.begin(), entries, it->second);
+    result = it->second->result;
+    ++hitCount;
+    return true;
+}
+
+void RouteCache::insert(int src, int dst, std::uint64_t version, const RouteResult& result) {
+    if (!adoptVersion(version)) {
+        return;
+    }
+
+    std::uint64_t key = packKey(src, dst);
+    auto it = index.find(key);
+    if (it != index.end()) {
+        it->second->result = result;
+        entries.splice(entries.begin(), entries, it->second);
+        return;
+    }
+
+    entries.push_front({key, result});
+    index[key] = entries.begin();
+    if (entries.size() > maxEntries) {
+        index.erase(entries.back().key);
+        entries.pop_back();
+    }
+}
+
+void RouteCache::clear() {
+    entries.clear();
+    index.clear();
+}
+
+std::size_t RouteCache::size() const {
+    return entries.size();
+}
+
+std::size_t RouteCache::capacity() const {
+    return maxEntries;
+}
+
+std::uint64_t RouteCache::hits() const {
+    return hitCount;
+}
+
+std::uint64_t RouteCache::misses() const {
+    return missCount;
+}
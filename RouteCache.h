@@ -0,0 +1,42 @@
+#ifndef ROUTECACHE_H
+#define ROUTECACHE_H
+
+#include "RoutingEngine.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+
+// 最短路径查询结果的 LRU 缓存
+// 条目以 (起点, 终点, 图版本) 为键；出现更新的图版本时旧条目全部作废
+class RouteCache {
+public:
+    explicit RouteCache(std::size_t capacity = 256); // 构造函数
+
+    bool lookup(int src, int dst, std::uint64_t version, RouteResult& result); // 查找，命中时写入 result
+    void insert(int src, int dst, std::uint64_t version, const RouteResult& result); // 写入（版本过旧时忽略）
+    void clear();                            // 清空条目（不清零计数）
+
+    std::size_t size() const;                // 当前条目数
+    std::size_t capacity() const;            // 最大条目数
+    std::uint64_t hits() const;              // 命中次数
+    std::uint64_t misses() const;            // 未命中次数
+
+private:
+    struct Entry {
+        std::uint64_t key;
+        RouteResult result;
+    };
+
+    static std::uint64_t packKey(int src, int dst);
+    bool adoptVersion(std::uint64_t version); // 切换到新版本，版本过旧返回 false
+
+    std::size_t maxEntries;
+    std::uint64_t currentVersion;
+    std::list<Entry> entries;                // 最近使用的在前
+    std::unordered_map<std::uint64_t, std::list<Entry>::iterator> index;
+    std::uint64_t hitCount;
+    std::uint64_t missCount;
+};
+
+#endif // ROUTECACHE_H
@@ -0,0 +1,164 @@
+#include "RoutingEngine.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+const double kInfinity = std::numeric_limits<double>::infinity();
+}
+
+RoutingEngine::RoutingEngine(std::shared_ptr<const CsrGraph> graph)
+    : graph(std::move(graph)), cancelFlag(nullptr) {
+    int n = this->graph->size();
+    dist.assign(n, kInfinity);
+    prev.assign(n, -1);
+    settled.assign(n, 0);
+    heap.reset(n);
+}
+
+const CsrGraph& RoutingEngine::csrGraph() const {
+    return *graph;
+}
+
+void RoutingEngine::setCancelFlag(const std::atomic_bool* flag) {
+    cancelFlag = flag;
+}
+
+RouteResult RoutingEngine::shortestPath(int src, int dst) {
+    return search(src, dst, false, nullptr);
+}
+
+RouteResult RoutingEngine::shortestPathAStar(int src, int dst) {
+    return search(src, dst, true, nullptr);
+}
+
+RouteResult RoutingEngine::shortestPathConstrained(int src, int dst, const SearchConstraints& constraints) {
+    return search(src, dst, false, &constraints);
+}
+
+bool RoutingEngine::shortestPathTree(int root, std::vector<double>& distances, std::vector<int>& parents) {
+    CAMPUS_PROFILE_SCOPE("routing.tree");
+    int n = graph->size();
+    distances.assign(n, kInfinity);
+    parents.assign(n, -1);
+    int source = graph->indexOf(root);
+    if (source == -1) {
+        return false;
+    }
+
+    // 图为无向图，从 root 出发的最短路径树即所有节点到 root 的最短路径树
+    resetWorkspace();
+    distances[source] = 0.0;
+    heap.push(source, 0.0);
+    while (!heap.empty()) {
+        if (cancelFlag && cancelFlag->load(std::memory_order_relaxed)) {
+            heap.clear();
+            return false;
+        }
+
+        int current = heap.pop();
+        double base = distances[current];
+        for (int e = graph->offsets[current]; e < graph->offsets[current + 1]; ++e) {
+            int neighbor = graph->neighbors[e];
+            double newDist = base + graph->weights[e];
+            if (newDist < distances[neighbor]) {
+                distances[neighbor] = newDist;
+                parents[neighbor] = current;
+                heap.push(neighbor, newDist);
+            }
+        }
+    }
+    return true;
+}
+
+// 边权即两端点的欧氏距离，因此直线距离是可采纳且一致的启发函数
+double RoutingEngine::heuristic(int index, int target) const {
+    return std::hypot(graph->xs[index] - graph->xs[target], graph->ys[index] - graph->ys[target]);
+}
+
+RouteResult RoutingEngine::search(int src, int dst, bool useHeuristic, const SearchConstraints* constraints) {
+    CAMPUS_PROFILE_SCOPE(constraints ? "routing.constrained" : useHeuristic ? "routing.astar" : "routing.dijkstra");
+    int source = graph->indexOf(src);
+    int target = graph->indexOf(dst);
+    if (source == -1 || target == -1) {
+        return RouteResult();
+    }
+
+    const std::vector<char>* bannedNodes = constraints ? constraints->bannedNodes : nullptr;
+    const std::vector<char>* bannedArcs = constraints ? constraints->bannedArcs : nullptr;
+    const std::vector<double>* potential = constraints ? constraints->potential : nullptr;
+    auto estimate = [&](int index) {
+        if (potential) return (*potential)[index];
+        return useHeuristic ? heuristic(index, target) : 0.0;
+    };
+
+    resetWorkspace();
+    dist[source] = 0.0;
+    touch(source);
+    heap.push(source, estimate(source));
+
+    int settledCount = 0;
+    while (!heap.empty()) {
+        if (cancelFlag && cancelFlag->load(std::memory_order_relaxed)) {
+            return RouteResult();
+        }
+
+        int current = heap.pop();
+        settled[current] = 1;
+        ++settledCount;
+        if (current == target) break;
+
+        double base = dist[current];
+        for (int e = graph->offsets[current]; e < graph->offsets[current + 1]; ++e) {
+            int neighbor = graph->neighbors[e];
+            if (settled[neighbor]) continue;
+            if (bannedArcs && (*bannedArcs)[e]) continue;
+            if (bannedNodes && (*bannedNodes)[neighbor]) continue;
+
+            double newDist = base + graph->weights[e];
+            if (newDist < dist[neighbor]) {
+                double key = newDist + estimate(neighbor);
+                if (key == kInfinity) continue; // 下界为无穷大说明无法到达终点
+                if (dist[neighbor] == kInfinity) touch(neighbor);
+                dist[neighbor] = newDist;
+                prev[neighbor] = current;
+                heap.push(neighbor, key);
+            }
+        }
+    }
+
+    return buildResult(source, target, settledCount);
+}
+
+void RoutingEngine::resetWorkspace() {
+    for (int index : touched) {
+        dist[index] = kInfinity;
+        prev[index] = -1;
+        settled[index] = 0;
+    }
+    touched.clear();
+    heap.clear();
+}
+
+void RoutingEngine::touch(int index) {
+    touched.push_back(index);
+}
+
+RouteResult RoutingEngine::buildResult(int source, int target, int settledCount) const {
+    RouteResult result;
+    result.settledCount = settledCount;
+    Profiler::count("routing.settledNodes", settledCount);
+    if (dist[target] == kInfinity) {
+        return result;
+    }
+
+    result.found = true;
+    result.distance = dist[target];
+    for (int at = target; at != -1; at = prev[at]) {
+        result.path.push_back(graph->vexNum(at));
+        if (at == source) break;
+    }
+    std::reverse(result.path.begin(), result.path.end());
+    return result;
+}
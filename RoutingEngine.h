@@ -0,0 +1,56 @@
+#ifndef ROUTINGENGINE_H
+#define ROUTINGENGINE_H
+
+#include "Graph.h"
+#include "IndexedHeap.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// 单次最短路径查询的结果
+struct RouteResult {
+    bool found = false;          // 是否可达
+    double distance = 0.0;       // 总距离
+    std::vector<int> path;       // 途经的节点编号（含起点和终点）
+    int settledCount = 0;        // 搜索中确定最短距离的节点数
+};
+
+// 受限搜索的附加条件（均以稠密下标或 CSR 边位置表示，可为空）
+struct SearchConstraints {
+    const std::vector<char>* bannedNodes = nullptr;   // 稠密下标 -> 是否禁止经过（对起点无效）
+    const std::vector<char>* bannedArcs = nullptr;    // CSR 边位置 -> 是否禁止通行（无向边需禁用两个方向）
+    const std::vector<double>* potential = nullptr;   // 稠密下标 -> 到终点距离的下界，用作 A* 启发函数
+};
+
+// 与界面无关的路径规划引擎，在不可变的CSR快照上运行
+// 工作数组在多次查询之间复用，只重置上次查询触及的部分
+class RoutingEngine {
+public:
+    explicit RoutingEngine(std::shared_ptr<const CsrGraph> graph); // 构造函数
+
+    RouteResult shortestPath(int src, int dst);  // Dijkstra 点对点最短路径（参数为节点编号）
+    RouteResult shortestPathAStar(int src, int dst); // 以直线距离为启发函数的 A* 最短路径
+    RouteResult shortestPathConstrained(int src, int dst, const SearchConstraints& constraints); // 避开禁用的节点和边
+    // 以 root 为根的完整最短路径树（稠密下标）：distances 为到 root 的距离，parents 为朝 root 方向的下一跳
+    bool shortestPathTree(int root, std::vector<double>& distances, std::vector<int>& parents);
+
+    const CsrGraph& csrGraph() const;            // 获取引擎使用的快照
+    void setCancelFlag(const std::atomic_bool* flag); // 设置取消标志，置位后查询提前返回“不可达”
+
+private:
+    RouteResult search(int src, int dst, bool useHeuristic, const SearchConstraints* constraints); // 各种搜索的公共实现
+    double heuristic(int index, int target) const; // 到终点的直线距离
+    void resetWorkspace();                       // 重置上次查询触及的工作数组
+    void touch(int index);                       // 记录被触及的下标
+    RouteResult buildResult(int source, int target, int settled) const; // 回溯路径
+
+    std::shared_ptr<const CsrGraph> graph;       // 邻接快照
+    const std::atomic_bool* cancelFlag;          // 取消标志（可为空）
+    std::vector<double> dist;                    // 稠密下标 -> 当前最短距离
+    std::vector<int> prev;                       // 稠密下标 -> 前驱下标
+    std::vector<char> settled;                   // 稠密下标 -> 是否已确定
+    std::vector<int> touched;                    // 本次查询触及的下标
+    IndexedHeap heap;                            // 带降键操作的优先队列
+};
+
+#endif // ROUTINGENGINE_H
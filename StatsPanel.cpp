@@ -0,0 +1,113 @@
+#include "StatsPanel.h"
+#include "Profiler.h"
+#include <QFile>
+#include <QFileDialog>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QVBoxLayout>
+
+namespace {
+const int kRefreshInterval = 1000;      // 表格刷新间隔（毫秒）
+
+QTableWidgetItem* numberItem(double value, int precision) {
+    auto* item = new QTableWidgetItem(QString::number(value, 'f', precision));
+    item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    return item;
+}
+}
+
+StatsPanel::StatsPanel(QWidget* parent)
+    : QDockWidget("性能统计", parent), refreshTimer(new QTimer(this)) {
+    auto* content = new QWidget(this);
+    auto* layout = new QVBoxLayout(content);
+
+    auto* toolbar = new QHBoxLayout();
+    enableCheckBox = new QCheckBox("启用采集", content);
+    enableCheckBox->setChecked(Profiler::isEnabled());
+    clearButton = new QPushButton("清空", content);
+    exportButton = new QPushButton("导出Trace", content);
+    toolbar->addWidget(enableCheckBox);
+    toolbar->addStretch();
+    toolbar->addWidget(clearButton);
+    toolbar->addWidget(exportButton);
+    layout->addLayout(toolbar);
+
+    table = new QTableWidget(0, 8, content);
+    table->setHorizontalHeaderLabels({"名称", "次数", "总计(ms)", "平均(µs)", "p50(µs)", "p95(µs)", "p99(µs)", "最大(µs)"});
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->setSelectionMode(QAbstractItemView::NoSelection);
+    table->verticalHeader()->setVisible(false);
+    table->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    layout->addWidget(table);
+    setWidget(content);
+
+    connect(enableCheckBox, &QCheckBox::toggled, this, [](bool checked) {
+        Profiler::instance().setEnabled(checked);
+    });
+    connect(clearButton, &QPushButton::clicked, this, [this]() {
+        Profiler::instance().reset();
+        refresh();
+    });
+    connect(exportButton, &QPushButton::clicked, this, &StatsPanel::exportTrace);
+
+    refreshTimer->setInterval(kRefreshInterval);
+    connect(refreshTimer, &QTimer::timeout, this, &StatsPanel::refresh);
+}
+
+void StatsPanel::showEvent(QShowEvent* event) {
+    QDockWidget::showEvent(event);
+    refresh();
+    refreshTimer->start();
+}
+
+void StatsPanel::hideEvent(QHideEvent* event) {
+    refreshTimer->stop();
+    QDockWidget::hideEvent(event);
+}
+
+void StatsPanel::refresh() {
+    auto stats = Profiler::instance().statistics();
+    auto counters = Profiler::instance().counters();
+    table->setRowCount(static_cast<int>(stats.size() + counters.size()));
+
+    int row = 0;
+    for (const auto& s : stats) {
+        table->setItem(row, 0, new QTableWidgetItem(QString::fromStdString(s.name)));
+        table->setItem(row, 1, numberItem(static_cast<double>(s.count), 0));
+        table->setItem(row, 2, numberItem(s.totalUs / 1000.0, 2));
+        table->setItem(row, 3, numberItem(s.meanUs, 1));
+        table->setItem(row, 4, numberItem(s.p50Us, 1));
+        table->setItem(row, 5, numberItem(s.p95Us, 1));
+        table->setItem(row, 6, numberItem(s.p99Us, 1));
+        table->setItem(row, 7, numberItem(s.maxUs, 1));
+        ++row;
+    }
+    // 计数器只有次数一列
+    for (const auto& c : counters) {
+        table->setItem(row, 0, new QTableWidgetItem(QString::fromStdString(c.name)));
+        table->setItem(row, 1, numberItem(static_cast<double>(c.value), 0));
+        for (int column = 2; column < table->columnCount(); ++column) {
+            table->setItem(row, column, new QTableWidgetItem());
+        }
+        ++row;
+    }
+}
+
+void StatsPanel::exportTrace() {
+    QString fileName = QFileDialog::getSaveFileName(this, "导出Trace", "", "Trace文件 (*.json);;所有文件 (*)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        QMessageBox::warning(this, "错误", "无法创建文件！");
+        return;
+    }
+    std::string json = Profiler::instance().chromeTrace();
+    if (file.write(json.data(), static_cast<qint64>(json.size())) != static_cast<qint64>(json.size())) {
+        QMessageBox::warning(this, "错误", "写入文件失败！");
+    }
+    file.close();
+}
@@ -0,0 +1,33 @@
+#ifndef STATSPANEL_H
+#define STATSPANEL_H
+
+#include <QDockWidget>
+#include <QTableWidget>
+#include <QCheckBox>
+#include <QPushButton>
+#include <QTimer>
+
+// 性能统计面板
+// 定时读取 Profiler 的耗时分布和计数器并显示在表格中，可导出 Chrome trace
+class StatsPanel : public QDockWidget {
+    Q_OBJECT
+public:
+    explicit StatsPanel(QWidget* parent = nullptr);
+
+protected:
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+
+private slots:
+    void refresh();                              // 重新填充表格
+    void exportTrace();                          // 把最近的事件写入 JSON 文件
+
+private:
+    QCheckBox* enableCheckBox;
+    QPushButton* clearButton;
+    QPushButton* exportButton;
+    QTableWidget* table;
+    QTimer* refreshTimer;
+};
+
+#endif // STATSPANEL_H
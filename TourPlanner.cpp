@@ -0,0 +1,318 @@
+#include "TourPlanner.h"
+#include "IndexedHeap.h"
+#include "Profiler.h"
+#include "RoutingEngine.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <thread>
+
+namespace {
+const double kInfinity = std::numeric_limits<double>::infinity();
+const double kEpsilon = 1e-9;           // 局部改进时忽略的微小收益
+const int kMaxOrOptSegment = 3;         // Or-opt 移动的最长片段
+}
+
+TourPlanner::TourPlanner(std::shared_ptr<const CsrGraph> graph)
+    : graph(std::move(graph)), cancelFlag(nullptr), threadCount(0) {}
+
+void TourPlanner::setThreadCount(int count) {
+    threadCount = count;
+}
+
+void TourPlanner::setCancelFlag(const std::atomic_bool* flag) {
+    cancelFlag = flag;
+}
+
+bool TourPlanner::isCancelled() const {
+    return cancelFlag && cancelFlag->load(std::memory_order_relaxed);
+}
+
+TourResult TourPlanner::plan(const std::vector<int>& stops, bool returnToStart) {
+    CAMPUS_PROFILE_SCOPE("tour.plan");
+    TourResult result;
+
+    // 转换为稠密下标并去重（保留首次出现的顺序）
+    std::vector<int> indexes;
+    std::vector<char> seen(graph->size(), 0);
+    for (int stop : stops) {
+        int index = graph->indexOf(stop);
+        if (index == -1) {
+            return result;
+        }
+        if (!seen[index]) {
+            seen[index] = 1;
+            indexes.push_back(index);
+        }
+    }
+    int k = static_cast<int>(indexes.size());
+    if (k == 0) {
+        return result;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<double> table = pairwiseDistances(indexes);
+    auto matrixDone = std::chrono::steady_clock::now();
+    result.matrixMilliseconds = std::chrono::duration<double, std::milli>(matrixDone - start).count();
+    if (isCancelled()) {
+        result.cancelled = true;
+        return result;
+    }
+    for (int j = 1; j < k; ++j) {
+        if (table[j] == kInfinity) {
+            return result;
+        }
+    }
+
+    std::vector<int> order;
+    if (k <= kExactStopLimit) {
+        order = heldKarp(table, k, !returnToStart);
+        result.exact = true;
+    } else {
+        // 扩展出一个到所有景点距离都为 0 的虚拟终点，开放路线与回路共用同一套局部改进
+        int stride = k + 1;
+        std::vector<double> extended(static_cast<size_t>(stride) * stride, 0.0);
+        for (int i = 0; i < k; ++i) {
+            std::copy(table.begin() + static_cast<size_t>(i) * k, table.begin() + static_cast<size_t>(i + 1) * k,
+                      extended.begin() + static_cast<size_t>(i) * stride);
+        }
+        std::vector<int> sequence = nearestNeighbor(table, k);
+        sequence.push_back(returnToStart ? 0 : k);
+        improve(sequence, extended, stride);
+        order.assign(sequence.begin(), sequence.end() - 1);
+    }
+    result.solveMilliseconds =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - matrixDone).count();
+
+    // 按访问顺序逐段还原路线
+    if (returnToStart && k > 1) {
+        order.push_back(0);
+    }
+    RoutingEngine engine(graph);
+    engine.setCancelFlag(cancelFlag);
+    result.path.push_back(graph->vexNum(indexes[order[0]]));
+    for (size_t i = 0; i + 1 < order.size(); ++i) {
+        RouteResult leg = engine.shortestPath(graph->vexNum(indexes[order[i]]), graph->vexNum(indexes[order[i + 1]]));
+        if (!leg.found) {
+            result.cancelled = isCancelled();
+            result.path.clear();
+            return result;
+        }
+        result.path.insert(result.path.end(), leg.path.begin() + 1, leg.path.end());
+        result.legDistances.push_back(leg.distance);
+        result.distance += leg.distance;
+    }
+    for (int stop : order) {
+        result.order.push_back(graph->vexNum(indexes[stop]));
+    }
+    result.found = true;
+    return result;
+}
+
+std::vector<double> TourPlanner::pairwiseDistances(const std::vector<int>& indexes) {
+    CAMPUS_PROFILE_SCOPE("tour.matrix");
+    int k = static_cast<int>(indexes.size());
+    std::vector<double> table(static_cast<size_t>(k) * k, kInfinity);
+    std::vector<int> stopOf(graph->size(), -1);
+    for (int i = 0; i < k; ++i) {
+        stopOf[indexes[i]] = i;
+    }
+
+    int threads = threadCount;
+    if (threads <= 0) {
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    threads = std::max(1, std::min(threads, k));
+
+    // 源点由各线程动态领取，每行只由一个线程写入
+    std::atomic_int nextSource(0);
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; ++t) {
+        workers.emplace_back(&TourPlanner::distanceRows, this, std::cref(indexes), std::cref(stopOf),
+                             std::ref(nextSource), std::ref(table));
+    }
+    distanceRows(indexes, stopOf, nextSource, table);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    return table;
+}
+
+void TourPlanner::distanceRows(const std::vector<int>& indexes, const std::vector<int>& stopOf,
+                               std::atomic_int& nextSource, std::vector<double>& table) {
+    const CsrGraph& g = *graph;
+    int n = g.size();
+    int k = static_cast<int>(indexes.size());
+    std::vector<double> dist(n, kInfinity);
+    std::vector<int> touched;
+    IndexedHeap heap(n);
+
+    for (int source = nextSource++; source < k; source = nextSource++) {
+        if (isCancelled()) {
+            return;
+        }
+
+        for (int index : touched) {
+            dist[index] = kInfinity;
+        }
+        touched.clear();
+        heap.clear();
+
+        double* row = &table[static_cast<size_t>(source) * k];
+        int remaining = k;
+        dist[indexes[source]] = 0.0;
+        touched.push_back(indexes[source]);
+        heap.push(indexes[source], 0.0);
+        // 所有景点都已确定距离后提前结束
+        while (!heap.empty() && remaining > 0) {
+            int current = heap.pop();
+            double base = dist[current];
+            if (stopOf[current] != -1) {
+                row[stopOf[current]] = base;
+                --remaining;
+            }
+            for (int e = g.offsets[current]; e < g.offsets[current + 1]; ++e) {
+                int neighbor = g.neighbors[e];
+                double newDist = base + g.weights[e];
+                if (newDist < dist[neighbor]) {
+                    if (dist[neighbor] == kInfinity) touched.push_back(neighbor);
+                    dist[neighbor] = newDist;
+                    heap.push(neighbor, newDist);
+                }
+            }
+        }
+    }
+}
+
+std::vector<int> TourPlanner::heldKarp(const std::vector<double>& table, int k, bool open) {
+    CAMPUS_PROFILE_SCOPE("tour.heldKarp");
+    if (k == 1) {
+        return {0};
+    }
+
+    // cost[mask * m + j]：从起点出发恰好访问 mask 中的景点、最后停在景点 j + 1 的最短距离
+    int m = k - 1;
+    size_t full = size_t(1) << m;
+    std::vector<double> cost(full * m, kInfinity);
+    std::vector<signed char> parent(full * m, -1);
+    for (int j = 0; j < m; ++j) {
+        cost[(size_t(1) << j) * m + j] = table[j + 1];
+    }
+    for (size_t mask = 1; mask < full; ++mask) {
+        for (int j = 0; j < m; ++j) {
+            double base = cost[mask * m + j];
+            if (!(mask & (size_t(1) << j)) || base == kInfinity) {
+                continue;
+            }
+            for (int next = 0; next < m; ++next) {
+                if (mask & (size_t(1) << next)) {
+                    continue;
+                }
+                size_t nextMask = mask | (size_t(1) << next);
+                double candidate = base + table[static_cast<size_t>(j + 1) * k + next + 1];
+                if (candidate < cost[nextMask * m + next]) {
+                    cost[nextMask * m + next] = candidate;
+                    parent[nextMask * m + next] = static_cast<signed char>(j);
+                }
+            }
+        }
+    }
+
+    size_t mask = full - 1;
+    int last = 0;
+    double best = kInfinity;
+    for (int j = 0; j < m; ++j) {
+        double total = cost[mask * m + j] + (open ? 0.0 : table[j + 1]);
+        if (total < best) {
+            best = total;
+            last = j;
+        }
+    }
+
+    std::vector<int> order(k);
+    for (int pos = k - 1; pos >= 1; --pos) {
+        order[pos] = last + 1;
+        int previous = parent[mask * m + last];
+        mask &= ~(size_t(1) << last);
+        last = previous;
+    }
+    order[0] = 0;
+    return order;
+}
+
+std::vector<int> TourPlanner::nearestNeighbor(const std::vector<double>& table, int k) {
+    std::vector<int> order;
+    std::vector<char> visited(k, 0);
+    int current = 0;
+    visited[0] = 1;
+    order.push_back(0);
+    for (int step = 1; step < k; ++step) {
+        int next = -1;
+        for (int j = 0; j < k; ++j) {
+            if (!visited[j] && (next == -1 || table[static_cast<size_t>(current) * k + j] <
+                                                  table[static_cast<size_t>(current) * k + next])) {
+                next = j;
+            }
+        }
+        visited[next] = 1;
+        order.push_back(next);
+        current = next;
+    }
+    return order;
+}
+
+void TourPlanner::improve(std::vector<int>& sequence, const std::vector<double>& table, int stride) {
+    CAMPUS_PROFILE_SCOPE("tour.localSearch");
+    auto d = [&](int a, int b) { return table[static_cast<size_t>(a) * stride + b]; };
+    // 首尾固定，只调整中间的景点
+    int last = static_cast<int>(sequence.size()) - 1;
+
+    bool improved = true;
+    while (improved) {
+        improved = false;
+
+        // 2-opt：反转 [i, j] 一段
+        for (int i = 1; i < last - 1; ++i) {
+            for (int j = i + 1; j < last; ++j) {
+                double delta = d(sequence[i - 1], sequence[j]) + d(sequence[i], sequence[j + 1]) -
+                               d(sequence[i - 1], sequence[i]) - d(sequence[j], sequence[j + 1]);
+                if (delta < -kEpsilon) {
+                    std::reverse(sequence.begin() + i, sequence.begin() + j + 1);
+                    improved = true;
+                }
+            }
+        }
+
+        // Or-opt：把 1~3 个连续景点（可反向）移动到其他位置
+        for (int length = 1; length <= kMaxOrOptSegment; ++length) {
+            for (int i = 1; i + length - 1 < last; ++i) {
+                int first = sequence[i];
+                int tail = sequence[i + length - 1];
+                int before = sequence[i - 1];
+                int after = sequence[i + length];
+                double removeGain = d(before, first) + d(tail, after) - d(before, after);
+                for (int p = 0; p < last; ++p) {
+                    if (p >= i - 1 && p < i + length) {
+                        continue;
+                    }
+                    int a = sequence[p];
+                    int b = sequence[p + 1];
+                    double forward = d(a, first) + d(tail, b) - d(a, b);
+                    double backward = d(a, tail) + d(first, b) - d(a, b);
+                    bool reversed = backward < forward;
+                    if (std::min(forward, backward) - removeGain < -kEpsilon) {
+                        std::vector<int> segment(sequence.begin() + i, sequence.begin() + i + length);
+                        if (reversed) {
+                            std::reverse(segment.begin(), segment.end());
+                        }
+                        sequence.erase(sequence.begin() + i, sequence.begin() + i + length);
+                        int insertAt = p < i ? p + 1 : p + 1 - length;
+                        sequence.insert(sequence.begin() + insertAt, segment.begin(), segment.end());
+                        improved = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef TOURPLANNER_H
+#define TOURPLANNER_H
+
+#include "Graph.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// 多景点游览路线的规划结果
+struct TourResult {
+    bool found = false;                      // 所有景点是否都能从起点到达
+    bool exact = false;                      // 访问顺序是否为精确最优解（Held-Karp）
+    bool cancelled = false;                  // 是否被取消
+    std::vector<int> order;                  // 景点的访问顺序（节点编号，首个为起点，回到起点时末尾再次出现起点）
+    std::vector<double> legDistances;        // 相邻两个景点之间的距离
+    std::vector<int> path;                   // 完整路线途经的节点编号
+    double distance = 0.0;                   // 总距离
+    double matrixMilliseconds = 0.0;         // 计算景点间距离表的耗时
+    double solveMilliseconds = 0.0;          // 求解访问顺序的耗时
+};
+
+// 多景点游览规划（旅行商问题），在不可变的CSR快照上运行
+// 先以各景点为源点并行运行 Dijkstra 得到景点间的距离表，再求访问顺序：
+// 景点不超过 kExactStopLimit 个时用 Held-Karp 动态规划求精确解，
+// 否则用最近邻构造初始路线，再反复做 2-opt 与 Or-opt 局部改进
+class TourPlanner {
+public:
+    static const int kExactStopLimit = 15;   // 使用精确算法的最大景点数
+
+    explicit TourPlanner(std::shared_ptr<const CsrGraph> graph); // 构造函数
+
+    // stops 为景点编号，第一个为起点，重复的景点只访问一次；returnToStart 为真时最后回到起点
+    TourResult plan(const std::vector<int>& stops, bool returnToStart);
+    void setThreadCount(int count);          // 计算距离表的线程数（0 表示使用全部硬件线程）
+    void setCancelFlag(const std::atomic_bool* flag); // 设置取消标志
+
+private:
+    bool isCancelled() const;
+    std::vector<double> pairwiseDistances(const std::vector<int>& indexes); // 景点间距离表（k * k）
+    void distanceRows(const std::vector<int>& indexes, const std::vector<int>& stopOf,
+                      std::atomic_int& nextSource, std::vector<double>& table); // 工作线程：领取源点并填充对应行
+
+    // 以下求解函数中景点用 [0, k) 表示，0 为起点；open 为真时不回到起点
+    static std::vector<int> heldKarp(const std::vector<double>& table, int k, bool open);
+    static std::vector<int> nearestNeighbor(const std::vector<double>& table, int k);
+    static void improve(std::vector<int>& sequence, const std::vector<double>& table, int stride);
+
+    std::shared_ptr<const CsrGraph> graph;   // 邻接快照
+    const std::atomic_bool* cancelFlag;      // 取消标志（可为空）
+    int threadCount;
+};
+
+#endif // TOURPLANNER_H
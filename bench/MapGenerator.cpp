@@ -0,0 +1,161 @@
+#include "MapGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+
+const double kSceneWidth = 800.0;
+const double kSceneHeight = 600.0;
+const double kPi = 3.14159265358979323846;
+
+void placeVertices(GeneratedMap& map, int vertexCount, std::mt19937& generator) {
+    std::uniform_real_distribution<double> distributionX(0.0, kSceneWidth);
+    std::uniform_real_distribution<double> distributionY(0.0, kSceneHeight);
+    map.vexs.resize(vertexCount);
+    for (int i = 0; i < vertexCount; ++i) {
+        Vex& vex = map.vexs[i];
+        vex.num = i;
+        vex.name = "v" + std::to_string(i);
+        vex.introduction = "合成节点";
+        vex.ticketInfo = "暂无门票信息";
+        vex.x = distributionX(generator);
+        vex.y = distributionY(generator);
+    }
+}
+
+void connect(GeneratedMap& map, int a, int b) {
+    const Vex& va = map.vexs[a];
+    const Vex& vb = map.vexs[b];
+    map.edges.push_back({a, b, std::hypot(va.x - vb.x, va.y - vb.y)});
+}
+
+} // namespace
+
+GeneratedMap MapGenerator::geometric(int vertexCount, std::uint32_t seed, double averageDegree) {
+    GeneratedMap map;
+    std::mt19937 generator(seed);
+    placeVertices(map, vertexCount, generator);
+    if (vertexCount < 2) {
+        return map;
+    }
+
+    // 期望度数 = 密度 * πr²，由此反解半径
+    double radius = std::sqrt(averageDegree * kSceneWidth * kSceneHeight / (kPi * vertexCount));
+
+    // 以半径为边长分桶，只比较相邻桶中的点对
+    int columns = std::max(1, static_cast<int>(kSceneWidth / radius));
+    int rows = std::max(1, static_cast<int>(kSceneHeight / radius));
+    std::vector<std::vector<int>> buckets(static_cast<size_t>(columns) * rows);
+    auto cellOf = [&](const Vex& vex, int& cx, int& cy) {
+        cx = std::min(columns - 1, static_cast<int>(vex.x / kSceneWidth * columns));
+        cy = std::min(rows - 1, static_cast<int>(vex.y / kSceneHeight * rows));
+    };
+    for (int i = 0; i < vertexCount; ++i) {
+        int cx;
+        int cy;
+        cellOf(map.vexs[i], cx, cy);
+        buckets[static_cast<size_t>(cy) * columns + cx].push_back(i);
+    }
+
+    double radiusSquared = radius * radius;
+    for (int i = 0; i < vertexCount; ++i) {
+        int cx;
+        int cy;
+        cellOf(map.vexs[i], cx, cy);
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                int nx = cx + dx;
+                int ny = cy + dy;
+                if (nx < 0 || ny < 0 || nx >= columns || ny >= rows) continue;
+                for (int j : buckets[static_cast<size_t>(ny) * columns + nx]) {
+                    if (j <= i) continue;
+                    double ddx = map.vexs[i].x - map.vexs[j].x;
+                    double ddy = map.vexs[i].y - map.vexs[j].y;
+                    if (ddx * ddx + ddy * ddy <= radiusSquared) {
+                        connect(map, i, j);
+                    }
+                }
+            }
+        }
+    }
+    return map;
+}
+
+GeneratedMap MapGenerator::grid(int vertexCount, std::uint32_t seed) {
+    GeneratedMap map;
+    std::mt19937 generator(seed);
+    placeVertices(map, vertexCount, generator);
+    if (vertexCount < 2) {
+        return map;
+    }
+
+    int columns = static_cast<int>(std::ceil(std::sqrt(vertexCount * kSceneWidth / kSceneHeight)));
+    int rows = (vertexCount + columns - 1) / columns;
+    double spacingX = kSceneWidth / columns;
+    double spacingY = kSceneHeight / std::max(1, rows);
+    std::uniform_real_distribution<double> jitter(-0.2, 0.2);
+    for (int i = 0; i < vertexCount; ++i) {
+        int column = i % columns;
+        int row = i / columns;
+        map.vexs[i].x = (column + 0.5 + jitter(generator)) * spacingX;
+        map.vexs[i].y = (row + 0.5 + jitter(generator)) * spacingY;
+    }
+    for (int i = 0; i < vertexCount; ++i) {
+        if (i % columns + 1 < columns && i + 1 < vertexCount) connect(map, i, i + 1);
+        if (i + columns < vertexCount) connect(map, i, i + columns);
+    }
+    return map;
+}
+
+GeneratedMap MapGenerator::scaleFree(int vertexCount, std::uint32_t seed, int edgesPerVertex) {
+    GeneratedMap map;
+    std::mt19937 generator(seed);
+    placeVertices(map, vertexCount, generator);
+    int m = std::max(1, edgesPerVertex);
+    if (vertexCount <= m) {
+        for (int i = 1; i < vertexCount; ++i) connect(map, i - 1, i);
+        return map;
+    }
+
+    // 初始为 m+1 个节点的完全图；endpoints 中每个节点按度数重复出现，均匀抽样即按度数加权
+    std::vector<int> endpoints;
+    for (int i = 0; i <= m; ++i) {
+        for (int j = i + 1; j <= m; ++j) {
+            connect(map, i, j);
+            endpoints.push_back(i);
+            endpoints.push_back(j);
+        }
+    }
+    std::vector<int> targets;
+    for (int v = m + 1; v < vertexCount; ++v) {
+        targets.clear();
+        while (static_cast<int>(targets.size()) < m) {
+            std::uniform_int_distribution<size_t> pick(0, endpoints.size() - 1);
+            int candidate = endpoints[pick(generator)];
+            if (std::find(targets.begin(), targets.end(), candidate) == targets.end()) {
+                targets.push_back(candidate);
+            }
+        }
+        for (int target : targets) {
+            connect(map, v, target);
+            endpoints.push_back(v);
+            endpoints.push_back(target);
+        }
+    }
+    return map;
+}
+
+GeneratedMap MapGenerator::generate(const std::string& kind, int vertexCount, std::uint32_t seed) {
+    if (kind == "geometric") return geometric(vertexCount, seed);
+    if (kind == "grid") return grid(vertexCount, seed);
+    if (kind == "scalefree") return scaleFree(vertexCount, seed);
+    return GeneratedMap();
+}
+
+void MapGenerator::load(const GeneratedMap& map, Graph& graph) {
+    graph.beginBulk();
+    graph.insertVexes(map.vexs);
+    graph.addEdges(map.edges);
+    graph.commit();
+}
@@ -0,0 +1,35 @@
+#ifndef MAPGENERATOR_H
+#define MAPGENERATOR_H
+
+#include "Graph.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 生成的合成地图：节点带坐标，边的端点为 vexs 中的下标（即空图中插入后的节点编号）
+struct GeneratedMap {
+    std::vector<Vex> vexs;
+    std::vector<Edge> edges;                 // 权重为两端直线距离
+};
+
+// 在 800x600 场景范围内生成合成校园地图，用于基准测试
+namespace MapGenerator {
+
+// 随机几何图：均匀撒点，连接距离不超过半径的点对，半径按期望平均度数选取
+GeneratedMap geometric(int vertexCount, std::uint32_t seed, double averageDegree = 6.0);
+
+// 网格校园：近似正方形的网格，四邻接，坐标带少量抖动
+GeneratedMap grid(int vertexCount, std::uint32_t seed);
+
+// 无标度图：Barabási–Albert 优先连接，每个新节点连接 edgesPerVertex 个已有节点
+GeneratedMap scaleFree(int vertexCount, std::uint32_t seed, int edgesPerVertex = 3);
+
+// 按名称生成（"geometric" / "grid" / "scalefree"），名称无效时返回空地图
+GeneratedMap generate(const std::string& kind, int vertexCount, std::uint32_t seed);
+
+// 把生成的地图批量装入空图
+void load(const GeneratedMap& map, Graph& graph);
+
+} // namespace MapGenerator
+
+#endif // MAPGENERATOR_H
@@ -0,0 +1,224 @@
+// campus-bench：图数据结构与算法的基准测试
+//
+// 用法：campus-bench [--sizes 100,1000,10000,100000] [--generators geometric,grid,scalefree]
+//                    [--repeats 3] [--seed 1] [--output 结果.json]
+// 在每种合成地图、每个规模上测量插入、建边、邻接表、删点、导入导出、
+// Dijkstra、Kruskal/Borůvka 与 DFS 枚举，结果以 JSON 输出，便于在版本间对比
+
+#include "DfsPathGenerator.h"
+#include "Graph.h"
+#include "GraphIO.h"
+#include "MapGenerator.h"
+#include "MstEngine.h"
+#include "RoutingEngine.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int kRouteQueries = 100;      // 每次 Dijkstra 测量执行的查询数
+const int kDfsMaxPaths = 1000;      // 与界面相同的 DFS 枚举上限
+const int kDfsMaxDepth = 64;
+const double kRemoveFraction = 0.01; // 删点测试删除的节点比例
+
+using Clock = std::chrono::steady_clock;
+
+struct Measurement {
+    std::string name;
+    std::string generator;
+    int vertices;
+    size_t edges;
+    long long items;                 // 一次测量处理的元素数（用于折算单个元素耗时）
+    std::vector<double> samples;     // 每次重复的耗时（纳秒）
+};
+
+std::vector<std::string> split(const std::string& text) {
+    std::vector<std::string> parts;
+    std::stringstream in(text);
+    std::string part;
+    while (std::getline(in, part, ',')) {
+        if (!part.empty()) parts.push_back(part);
+    }
+    return parts;
+}
+
+// 每次重复先执行不计时的 setup，再对 body 计时
+std::vector<double> measure(int repeats, const std::function<void()>& setup, const std::function<void()>& body) {
+    std::vector<double> samples;
+    for (int r = 0; r < repeats; ++r) {
+        setup();
+        auto start = Clock::now();
+        body();
+        samples.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+    }
+    return samples;
+}
+
+void writeJson(std::ostream& out, const std::vector<Measurement>& results, unsigned int seed, int repeats) {
+    out << "{\n  \"seed\": " << seed << ",\n  \"repeats\": " << repeats << ",\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Measurement& m = results[i];
+        std::vector<double> sorted(m.samples);
+        std::sort(sorted.begin(), sorted.end());
+        double mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+        double median = sorted[sorted.size() / 2];
+        char buffer[512];
+        std::snprintf(buffer, sizeof(buffer),
+                      "    {\"name\": \"%s\", \"generator\": \"%s\", \"vertices\": %d, \"edges\": %zu, "
+                      "\"items\": %lld, \"min_ns\": %.0f, \"median_ns\": %.0f, \"mean_ns\": %.0f, "
+                      "\"ns_per_item\": %.2f}%s\n",
+                      m.name.c_str(), m.generator.c_str(), m.vertices, m.edges, m.items,
+                      sorted.front(), median, mean, median / std::max(1LL, m.items),
+                      i + 1 < results.size() ? "," : "");
+        out << buffer;
+    }
+    out << "  ]\n}\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<int> sizes = {100, 1000, 10000, 100000};
+    std::vector<std::string> generators = {"geometric", "grid", "scalefree"};
+    int repeats = 3;
+    unsigned int seed = 1;
+    std::string outputFile;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string option = argv[i];
+        std::string value = argv[i + 1];
+        if (option == "--sizes") {
+            sizes.clear();
+            for (const auto& part : split(value)) sizes.push_back(std::stoi(part));
+        } else if (option == "--generators") {
+            generators = split(value);
+        } else if (option == "--repeats") {
+            repeats = std::max(1, std::stoi(value));
+        } else if (option == "--seed") {
+            seed = static_cast<unsigned int>(std::stoul(value));
+        } else if (option == "--output") {
+            outputFile = value;
+        } else {
+            std::cerr << "未知参数：" << option << "\n";
+            return 2;
+        }
+    }
+
+    std::vector<Measurement> results;
+    for (const auto& kind : generators) {
+        for (int n : sizes) {
+            GeneratedMap map = MapGenerator::generate(kind, n, seed);
+            if (map.vexs.empty()) {
+                std::cerr << "未知的地图类型：" << kind << "\n";
+                return 2;
+            }
+            size_t m = map.edges.size();
+            std::cerr << "# " << kind << " n=" << n << " m=" << m << "\n";
+            auto record = [&](const std::string& name, long long items, std::vector<double> samples) {
+                results.push_back({name, kind, n, m, items, std::move(samples)});
+            };
+            auto noSetup = []() {};
+
+            // 逐个插入节点
+            Graph graph;
+            record("insertVex", n, measure(repeats, [&]() { graph.clearGraph(); }, [&]() {
+                for (const auto& vex : map.vexs) graph.insertVex(vex);
+            }));
+
+            // 逐条添加边（节点已存在）
+            record("addEdge", static_cast<long long>(m), measure(repeats, [&]() { graph.clearEdges(); }, [&]() {
+                for (const auto& edge : map.edges) graph.addEdge(edge.vex1, edge.vex2, edge.weight);
+            }));
+
+            // 批量构建整个图
+            record("bulkBuild", n + static_cast<long long>(m), measure(repeats, [&]() { graph.clearGraph(); }, [&]() {
+                MapGenerator::load(map, graph);
+            }));
+
+            record("getAdjacencyList", n, measure(repeats, noSetup, [&]() {
+                auto adjacency = graph.getAdjacencyList();
+                (void)adjacency;
+            }));
+
+            // 删除一部分随机节点
+            std::vector<int> victims(n);
+            std::iota(victims.begin(), victims.end(), 0);
+            std::shuffle(victims.begin(), victims.end(), std::mt19937(seed));
+            victims.resize(std::max(1, static_cast<int>(n * kRemoveFraction)));
+            Graph scratch;
+            record("removeVex", static_cast<long long>(victims.size()), measure(repeats, [&]() {
+                scratch.clearGraph();
+                MapGenerator::load(map, scratch);
+            }, [&]() {
+                for (int id : victims) scratch.removeVex(id);
+            }));
+
+            // 文本导出与导入（导入包括解析与批量构建）
+            std::string text;
+            record("exportText", n + static_cast<long long>(m), measure(repeats, noSetup, [&]() {
+                text = GraphIO::writeText(graph);
+            }));
+            record("importText", n + static_cast<long long>(m), measure(repeats, [&]() { scratch.clearGraph(); }, [&]() {
+                ParsedGraph parsed;
+                std::string error;
+                GraphIO::parseText(text, parsed, error);
+                GraphIO::buildGraph(parsed, seed, scratch);
+            }));
+
+            // 最短路径：固定的随机点对
+            auto csr = graph.getCsrGraph();
+            std::mt19937 queryGenerator(seed + 1);
+            std::uniform_int_distribution<int> pick(0, n - 1);
+            std::vector<std::pair<int, int>> queries;
+            for (int q = 0; q < kRouteQueries; ++q) queries.push_back({pick(queryGenerator), pick(queryGenerator)});
+            RoutingEngine engine(csr);
+            record("dijkstra", kRouteQueries, measure(repeats, noSetup, [&]() {
+                for (const auto& query : queries) engine.shortestPath(query.first, query.second);
+            }));
+            record("astar", kRouteQueries, measure(repeats, noSetup, [&]() {
+                for (const auto& query : queries) engine.shortestPathAStar(query.first, query.second);
+            }));
+
+            MstEngine mstEngine(csr);
+            record("kruskal", static_cast<long long>(m), measure(repeats, noSetup, [&]() { mstEngine.kruskal(); }));
+            record("boruvka", static_cast<long long>(m), measure(repeats, noSetup, [&]() { mstEngine.boruvka(); }));
+
+            // 实际枚举出的路径数可能少于上限，按每次重复真实产出的条数折算
+            std::vector<long long> producedCounts;
+            std::vector<double> dfsSamples = measure(repeats, noSetup, [&]() {
+                DfsPathGenerator generator(csr, queries.front().first, kDfsMaxPaths, kDfsMaxDepth);
+                std::vector<int> path;
+                long long produced = 0;
+                while (generator.next(path)) ++produced;
+                producedCounts.push_back(produced);
+            });
+            auto countRange = std::minmax_element(producedCounts.begin(), producedCounts.end());
+            if (*countRange.first != *countRange.second) {
+                std::cerr << "# dfsEnumerate 各次重复的路径数不一致：" << *countRange.first << " - "
+                          << *countRange.second << "\n";
+            }
+            record("dfsEnumerate", *countRange.first, std::move(dfsSamples));
+        }
+    }
+
+    if (outputFile.empty()) {
+        writeJson(std::cout, results, seed, repeats);
+    } else {
+        std::ofstream out(outputFile);
+        if (!out) {
+            std::cerr << "无法创建文件：" << outputFile << "\n";
+            return 1;
+        }
+        writeJson(out, results, seed, repeats);
+    }
+    return 0;
+}
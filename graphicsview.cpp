@@ -1,32 +1,58 @@
-#include "GraphicsView.h"
+#include "graphicsview.h"
+#include "Profiler.h"
 #include <QMimeData>
-#include <QDebug>
+#include <QtMath>
+
+namespace {
+const qreal kMinZoom = 0.05;
+const qreal kMaxZoom = 10.0;
+}
 
 GraphicsView::GraphicsView(QWidget* parent)
     : QGraphicsView(parent) {
     setAcceptDrops(true);
     viewport()->setAcceptDrops(true);
+
+    // 以鼠标位置为中心缩放；只重绘变化区域，重绘代价取决于可见内容
+    setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
+    setViewportUpdateMode(QGraphicsView::SmartViewportUpdate);
+    setOptimizationFlag(QGraphicsView::DontAdjustForAntialiasing);
+}
+
+qreal GraphicsView::zoomLevel() const {
+    return transform().m11();
+}
+
+void GraphicsView::wheelEvent(QWheelEvent* event) {
+    qreal steps = event->angleDelta().y() / 120.0;
+    if (steps == 0) {
+        QGraphicsView::wheelEvent(event);
+        return;
+    }
+
+    qreal factor = qPow(1.15, steps);
+    qreal target = qBound(kMinZoom, zoomLevel() * factor, kMaxZoom);
+    factor = target / zoomLevel();
+    scale(factor, factor);
+    event->accept();
 }
 
 void GraphicsView::dragEnterEvent(QDragEnterEvent* event) {
     if (event->mimeData()->hasText()) {
         event->setDropAction(Qt::MoveAction);
         event->accept();
-        qDebug() << "GraphicsView: dragEnterEvent accepted";
     } else {
         event->ignore();
-        qDebug() << "GraphicsView: dragEnterEvent ignored";
     }
 }
 
 void GraphicsView::dragMoveEvent(QDragMoveEvent* event) {
+    Profiler::count("view.dragMoveEvents");
     if (event->mimeData()->hasText()) {
         event->setDropAction(Qt::MoveAction);
         event->accept();
-        qDebug() << "GraphicsView: dragMoveEvent accepted";
     } else {
         event->ignore();
-        qDebug() << "GraphicsView: dragMoveEvent ignored";
     }
 }
 
@@ -39,10 +65,8 @@ void GraphicsView::dropEvent(QDropEvent* event) {
 
         event->setDropAction(Qt::MoveAction);
         event->accept();
-
-        qDebug() << "GraphicsView: Node" << nodeId << "dropped at position" << position;
+        Profiler::count("view.nodeDrops");
     } else {
         event->ignore();
-        qDebug() << "GraphicsView: dropEvent ignored";
     }
 }
@@ -4,12 +4,19 @@
 #include <QGraphicsView>
 #include <QDragEnterEvent>
 #include <QDropEvent>
+#include <QWheelEvent>
 
 class GraphicsView : public QGraphicsView {
     Q_OBJECT
 public:
     explicit GraphicsView(QWidget* parent = nullptr);
 
+    // 细节层次阈值（图元在 paint() 中比较 levelOfDetailFromTransform 的结果）
+    static constexpr qreal kLabelLodThreshold = 0.6; // 低于此缩放不绘制文字标签
+    static constexpr qreal kNodeLodThreshold = 0.3;  // 低于此缩放节点退化为点
+
+    qreal zoomLevel() const;                         // 当前缩放比例
+
 signals:
     void nodeDropped(int nodeId, QPointF position);
 
@@ -17,6 +24,7 @@ protected:
     void dragEnterEvent(QDragEnterEvent* event) override;
     void dragMoveEvent(QDragMoveEvent* event) override; // 添加此行
     void dropEvent(QDropEvent* event) override;
+    void wheelEvent(QWheelEvent* event) override;    // 滚轮缩放
 };
 
 #endif // GRAPHICSVIEW_H
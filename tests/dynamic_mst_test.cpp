@@ -0,0 +1,118 @@
+// 动态最小生成森林的随机测试：每次插入、删除、改权重后与 Kruskal 的结果比较
+
+#include "DynamicMst.h"
+#include "EdgeStore.h"
+#include "MstEngine.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* what, int step) {
+    if (!condition) {
+        std::printf("失败（第 %d 步）：%s\n", step, what);
+        ++failures;
+    }
+}
+
+// 参考实现：对当前边集做一次 Kruskal，返回总权重与树边数
+double kruskal(const std::map<std::uint64_t, Edge>& edges, int vertexCount, int& treeEdgeCount) {
+    std::vector<Edge> sorted;
+    sorted.reserve(edges.size());
+    for (const auto& pair : edges) {
+        sorted.push_back(pair.second);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Edge& a, const Edge& b) {
+        return a.weight < b.weight;
+    });
+    DisjointSet sets(vertexCount);
+    double total = 0.0;
+    treeEdgeCount = 0;
+    for (const auto& edge : sorted) {
+        if (sets.unite(edge.vex1, edge.vex2)) {
+            total += edge.weight;
+            ++treeEdgeCount;
+        }
+    }
+    return total;
+}
+
+void runRandom(unsigned seed, int vertexCount, int steps) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> pickVex(0, vertexCount - 1);
+    std::uniform_int_distribution<int> pickOp(0, 9);
+    // 权重取整数，重复权重较多，可以覆盖等权替换的情况
+    std::uniform_int_distribution<int> pickWeight(1, 20);
+
+    DynamicMst mst;
+    std::map<std::uint64_t, Edge> edges;
+    for (int step = 0; step < steps; ++step) {
+        int op = pickOp(rng);
+        if (op < 5 || edges.empty()) {
+            int a = pickVex(rng);
+            int b = pickVex(rng);
+            if (a == b) {
+                continue;
+            }
+            double weight = pickWeight(rng);
+            mst.insertEdge(a, b, weight);
+            edges[EdgeStore::packKey(a, b)] = {std::min(a, b), std::max(a, b), weight};
+        } else {
+            auto it = edges.begin();
+            std::advance(it, std::uniform_int_distribution<int>(0, static_cast<int>(edges.size()) - 1)(rng));
+            if (op < 8) {
+                mst.removeEdge(it->second.vex2, it->second.vex1);
+                edges.erase(it);
+            } else {
+                double weight = pickWeight(rng);
+                mst.updateWeight(it->second.vex1, it->second.vex2, weight);
+                it->second.weight = weight;
+            }
+        }
+
+        int expectedCount = 0;
+        double expected = kruskal(edges, vertexCount, expectedCount);
+        check(std::fabs(mst.totalWeight() - expected) < 1e-6, "总权重与 Kruskal 一致", step);
+
+        std::vector<Edge> tree = mst.treeEdges();
+        check(static_cast<int>(tree.size()) == expectedCount, "树边数与 Kruskal 一致", step);
+        double sum = 0.0;
+        DisjointSet sets(vertexCount);
+        bool acyclic = true;
+        for (const auto& edge : tree) {
+            sum += edge.weight;
+            acyclic = sets.unite(edge.vex1, edge.vex2) && acyclic;
+            auto found = edges.find(EdgeStore::packKey(edge.vex1, edge.vex2));
+            check(found != edges.end() && found->second.weight == edge.weight, "树边存在于当前边集", step);
+        }
+        check(acyclic, "森林中没有环", step);
+        check(std::fabs(sum - mst.totalWeight()) < 1e-6, "树边权重之和等于 totalWeight", step);
+        if (failures > 0) {
+            return;
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    // 稀疏图会频繁断开，稠密图会频繁发生替换
+    runRandom(1, 12, 4000);
+    runRandom(2, 40, 4000);
+    runRandom(3, 120, 3000);
+    for (unsigned seed = 10; seed < 20 && failures == 0; ++seed) {
+        runRandom(seed, 8, 1000);
+    }
+
+    if (failures == 0) {
+        std::printf("全部通过\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,57 @@
+// 文本地图解析的损坏输入测试：伪造的数量和截断的内容都应返回错误，而不是抛出异常
+
+#include "GraphIO.h"
+#include <cstdio>
+#include <exception>
+#include <string>
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (!condition) {
+        std::printf("失败：%s\n", what);
+        ++failures;
+    }
+}
+
+// 解析失败且给出错误信息；任何异常都算作失败
+bool rejects(const std::string& text, const std::string& expected) {
+    try {
+        ParsedGraph parsed;
+        std::string error;
+        return !GraphIO::parseText(text, parsed, error) && error.find(expected) != std::string::npos;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+} // namespace
+
+int main() {
+    const std::string valid = "3\n图书馆\n藏书\n食堂\n吃饭\n宿舍\n休息\n2\n图书馆 食堂\n食堂 宿舍\n";
+    {
+        ParsedGraph parsed;
+        std::string error;
+        check(GraphIO::parseText(valid, parsed, error), "正常文本可以解析");
+        check(parsed.vexs.size() == 3 && parsed.edges.size() == 2, "节点数与边数正确");
+        check(parsed.vexs.size() == 3 && parsed.vexs[2].name == "宿舍", "节点名称正确");
+    }
+
+    check(rejects("2000000000", "节点信息不足"), "只有巨大节点数的文件被拒绝");
+    check(rejects("2000000000\n甲\n乙\n", "节点信息不足"), "节点数远超内容的文件被拒绝");
+    check(rejects("1\n甲\n介绍\n2000000000\n", "边信息不足"), "只有巨大边数的文件被拒绝");
+    check(rejects("3\n图书馆\n藏书\n食堂\n吃饭\n宿舍\n", "节点信息不足"), "截断的节点列表被拒绝");
+    check(rejects("3\n图书馆\n藏书\n食堂\n吃饭\n宿舍\n休息\n2\n图书馆 食堂\n", "边信息不足"), "截断的边列表被拒绝");
+    check(rejects("3\n图书馆\n藏书\n食堂\n吃饭\n宿舍\n休息\n1\n图书馆\n", "边格式不正确"), "缺少终点的边被拒绝");
+    check(rejects("", "节点数量无效"), "空文件被拒绝");
+    check(rejects("-5\n", "节点数量无效"), "负的节点数被拒绝");
+    check(rejects("99999999999999999999\n", "节点数量无效"), "溢出的节点数被拒绝");
+    check(rejects("1\n甲\n介绍\n-1\n", "边数量无效"), "负的边数被拒绝");
+
+    if (failures == 0) {
+        std::printf("全部通过\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
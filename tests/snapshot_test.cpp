@@ -0,0 +1,141 @@
+// 图快照的往返与损坏文件测试：任何损坏的输入都应被 open/load 拒绝，而不是越界访问
+
+#include "Graph.h"
+#include "GraphSnapshot.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (!condition) {
+        std::printf("失败：%s\n", what);
+        ++failures;
+    }
+}
+
+Graph sampleGraph() {
+    Graph graph;
+    const char* names[] = {"图书馆", "食堂", "宿舍", "操场"};
+    for (int i = 0; i < 4; ++i) {
+        Vex vex;
+        vex.name = names[i];
+        vex.introduction = "介绍";
+        vex.x = 100.0 * i;
+        vex.y = 50.0 * i;
+        graph.insertVex(vex);
+    }
+    graph.addEdge(0, 1, 10.0);
+    graph.addEdge(1, 2, 20.0);
+    graph.addEdge(2, 3, 30.0);
+    graph.addEdge(0, 3, 40.0);
+    return graph;
+}
+
+GraphSnapshot::Header* headerOf(std::string& bytes) {
+    return reinterpret_cast<GraphSnapshot::Header*>(&bytes[0]);
+}
+
+bool rejects(const std::string& bytes) {
+    Graph graph;
+    std::string error;
+    return !GraphSnapshot::load(bytes, graph, error) && !error.empty();
+}
+
+} // namespace
+
+int main() {
+    Graph original = sampleGraph();
+    std::string bytes;
+    std::string serializeError;
+    check(GraphSnapshot::serialize(original, bytes, serializeError), "正常图可以序列化");
+
+    // 往返
+    {
+        Graph loaded;
+        std::string error;
+        check(GraphSnapshot::load(bytes, loaded, error), "正常快照可以加载");
+        check(loaded.getAllVexs().size() == 4, "节点数一致");
+        check(loaded.getAllEdges().size() == 4, "边数一致");
+        check(loaded.getVex(loaded.getVexIndex("宿舍")).x == 200.0, "坐标一致");
+    }
+
+    // 未按 8 字节对齐的缓冲区
+    {
+        std::string shifted = " " + bytes;
+        Graph loaded;
+        std::string error;
+        check(GraphSnapshot::load(std::string_view(shifted).substr(1), loaded, error), "未对齐的缓冲区可以加载");
+    }
+
+    // 截断
+    for (size_t size = 0; size < bytes.size(); ++size) {
+        if (!rejects(bytes.substr(0, size))) {
+            std::printf("失败：截断为 %zu 字节的快照未被拒绝\n", size);
+            ++failures;
+            break;
+        }
+    }
+
+    // 字符串表大小溢出：布局之和回绕到文件大小以内
+    {
+        std::string corrupt = bytes;
+        headerOf(corrupt)->stringTableSize = UINT64_MAX - 15;
+        check(rejects(corrupt), "溢出的字符串表大小被拒绝");
+    }
+    // 邻接项数溢出
+    {
+        std::string corrupt = bytes;
+        headerOf(corrupt)->adjacencyCount = UINT64_MAX / 4;
+        check(rejects(corrupt), "溢出的邻接项数被拒绝");
+    }
+    // 节点数超出文件大小
+    {
+        std::string corrupt = bytes;
+        headerOf(corrupt)->vertexCount = UINT32_MAX;
+        check(rejects(corrupt), "过大的节点数被拒绝");
+    }
+
+    // 定位各段，逐项破坏
+    const GraphSnapshot::Header header = *headerOf(bytes);
+    size_t verticesAt = (sizeof(GraphSnapshot::Header) + 7) & ~size_t(7);
+    size_t offsetsAt = (verticesAt + header.vertexCount * sizeof(GraphSnapshot::VertexRecord) + 7) & ~size_t(7);
+    size_t neighborsAt = (offsetsAt + (header.vertexCount + 1) * sizeof(std::uint32_t) + 7) & ~size_t(7);
+    size_t weightsAt = (neighborsAt + header.adjacencyCount * sizeof(std::uint32_t) + 7) & ~size_t(7);
+
+    {
+        std::string corrupt = bytes;
+        std::uint32_t badName = static_cast<std::uint32_t>(header.stringTableSize);
+        std::memcpy(&corrupt[verticesAt], &badName, sizeof(badName));
+        check(rejects(corrupt), "越界的字符串偏移被拒绝");
+    }
+    {
+        std::string corrupt = bytes;
+        std::uint32_t badOffset = static_cast<std::uint32_t>(header.adjacencyCount + 1);
+        std::memcpy(&corrupt[offsetsAt + sizeof(std::uint32_t)], &badOffset, sizeof(badOffset));
+        check(rejects(corrupt), "非单调的邻接偏移被拒绝");
+    }
+    {
+        std::string corrupt = bytes;
+        std::uint32_t badNeighbor = header.vertexCount;
+        std::memcpy(&corrupt[neighborsAt], &badNeighbor, sizeof(badNeighbor));
+        check(rejects(corrupt), "越界的邻居下标被拒绝");
+    }
+    const double badWeights[] = {-1.0, std::numeric_limits<double>::quiet_NaN(),
+                                 std::numeric_limits<double>::infinity()};
+    for (double weight : badWeights) {
+        std::string corrupt = bytes;
+        std::memcpy(&corrupt[weightsAt], &weight, sizeof(weight));
+        check(rejects(corrupt), "负数或非有限的权重被拒绝");
+    }
+
+    if (failures == 0) {
+        std::printf("全部通过\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,310 @@
+// campus-query：无界面的校园导游图查询工具
+//
+// 用法：campus-query <地图文件> [查询文件] [--seed N] [--trace 输出文件]
+//   地图文件为 .txt 文本格式或 .ctg 二进制快照；文本格式不含坐标，
+//   节点按种子随机放置在 800x600 的场景内，边权为两端直线距离（与界面导入一致）
+//   查询从查询文件读取，未给出时读取标准输入，每行一条：
+//     path <起点> <终点>     Dijkstra 最短路径
+//     astar <起点> <终点>    A* 最短路径
+//     ch <起点> <终点>       收缩层次最短路径（首次使用时构建索引）
+//     mst                    最小生成树（森林）
+//     dfs <起点> [最多路径数] 深度优先枚举极大简单路径
+//     kpaths <起点> <终点> [k] 前 k 条最短简单路径（Yen 算法）
+//     tour <起点> <景点>...  从起点出发游览所有景点的路线（不回到起点）
+//     stats                  图的规模
+//   每条查询输出结果和耗时，结束时输出汇总（查询数、总耗时、吞吐量）
+//   给出 --trace 时开启性能采集，结束时输出各阶段的耗时分位数并写出 Chrome trace JSON
+
+#include "ContractionHierarchy.h"
+#include "DfsPathGenerator.h"
+#include "Graph.h"
+#include "GraphIO.h"
+#include "GraphSnapshot.h"
+#include "KShortestPaths.h"
+#include "MstEngine.h"
+#include "Profiler.h"
+#include "RoutingEngine.h"
+#include "TourPlanner.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int kDefaultDfsPaths = 10;
+const int kDefaultKPaths = 5;
+
+using Clock = std::chrono::steady_clock;
+
+bool endsWith(const std::string& s, const std::string& suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+bool readFile(const std::string& fileName, std::string& content) {
+    std::ifstream in(fileName, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+// 按界面导入的规则把文本格式装入图：随机坐标，边权为直线距离
+bool loadText(const std::string& content, unsigned int seed, Graph& graph, std::string& error) {
+    ParsedGraph parsed;
+    if (!GraphIO::parseText(content, parsed, error)) {
+        return false;
+    }
+    GraphIO::buildGraph(parsed, seed, graph);
+    return true;
+}
+
+std::string pathToString(const Graph& graph, const std::vector<int>& path) {
+    std::string text;
+    for (size_t i = 0; i < path.size(); ++i) {
+        if (i > 0) text += " -> ";
+        text += graph.getVex(path[i]).name;
+    }
+    return text;
+}
+
+// 查询处理器：持有快照和按需构建的索引，快照在整个会话中不变
+class QuerySession {
+public:
+    explicit QuerySession(const Graph& graph)
+        : graph(graph), csr(graph.getCsrGraph()), engine(csr) {}
+
+    // 执行一条查询，结果写入 out；无法识别时返回 false
+    bool run(const std::string& line, std::ostream& out) {
+        std::istringstream in(line);
+        std::string command;
+        in >> command;
+
+        if (command == "path" || command == "astar" || command == "ch") {
+            std::string from;
+            std::string to;
+            in >> from >> to;
+            int src = graph.getVexIndex(from);
+            int dst = graph.getVexIndex(to);
+            if (src == -1 || dst == -1) {
+                out << "起点或终点不存在！";
+                return true;
+            }
+
+            RouteResult route;
+            if (command == "path") {
+                route = engine.shortestPath(src, dst);
+            } else if (command == "astar") {
+                route = engine.shortestPathAStar(src, dst);
+            } else {
+                if (!chIndex) {
+                    chIndex = std::make_unique<ContractionHierarchy>(csr);
+                }
+                route = chIndex->shortestPath(src, dst);
+            }
+            if (!route.found) {
+                out << "无法到达目标节点！";
+            } else {
+                out << pathToString(graph, route.path) << "，总距离：" << route.distance
+                    << "，确定节点数：" << route.settledCount;
+            }
+            return true;
+        }
+
+        if (command == "mst") {
+            MstEngine mstEngine(csr);
+            MstResult mst = mstEngine.kruskal();
+            out << "边数：" << mst.edges.size() << "，总权重：" << mst.totalWeight
+                << "，连通分量：" << mst.componentCount;
+            return true;
+        }
+
+        if (command == "dfs") {
+            std::string from;
+            int maxPaths = kDefaultDfsPaths;
+            in >> from >> maxPaths;
+            int src = graph.getVexIndex(from);
+            if (src == -1) {
+                out << "起点不存在！";
+                return true;
+            }
+            DfsPathGenerator generator(csr, src, maxPaths);
+            out << "从 " << from << " 出发的路径：";
+            std::vector<int> path;
+            while (generator.next(path)) {
+                out << "\n  " << pathToString(graph, path);
+            }
+            out << "\n  共 " << generator.producedCount() << " 条" << (generator.hitLimit() ? "（已截断）" : "");
+            return true;
+        }
+
+        if (command == "kpaths") {
+            std::string from;
+            std::string to;
+            int k = kDefaultKPaths;
+            in >> from >> to >> k;
+            int src = graph.getVexIndex(from);
+            int dst = graph.getVexIndex(to);
+            if (src == -1 || dst == -1) {
+                out << "起点或终点不存在！";
+                return true;
+            }
+            KShortestPaths finder(csr);
+            std::vector<RouteResult> routes = finder.find(src, dst, k);
+            if (routes.empty()) {
+                out << "无法到达目标节点！";
+                return true;
+            }
+            for (size_t i = 0; i < routes.size(); ++i) {
+                out << (i ? "\n  " : "") << (i + 1) << ". " << pathToString(graph, routes[i].path)
+                    << "，总距离：" << routes[i].distance;
+            }
+            out << "\n  偏离搜索 " << finder.spurSearchCount() << " 次，复用最短路径树 "
+                << finder.treeReuseCount() << " 次";
+            return true;
+        }
+
+        if (command == "tour") {
+            std::vector<int> stops;
+            std::string name;
+            while (in >> name) {
+                int idx = graph.getVexIndex(name);
+                if (idx == -1) {
+                    out << "景点不存在：" << name;
+                    return true;
+                }
+                stops.push_back(idx);
+            }
+            TourPlanner planner(csr);
+            TourResult tour = planner.plan(stops, false);
+            if (!tour.found) {
+                out << "部分景点之间无法到达！";
+            } else {
+                out << pathToString(graph, tour.order) << "，总距离：" << tour.distance
+                    << (tour.exact ? "（最优解）" : "（启发式）");
+            }
+            return true;
+        }
+
+        if (command == "stats") {
+            out << "节点数：" << csr->size() << "，边数：" << csr->neighbors.size() / 2;
+            return true;
+        }
+        return false;
+    }
+
+private:
+    const Graph& graph;
+    std::shared_ptr<const CsrGraph> csr;
+    RoutingEngine engine;
+    std::unique_ptr<ContractionHierarchy> chIndex;
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string mapFile;
+    std::string queryFile;
+    std::string traceFile;
+    unsigned int seed = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--seed" && i + 1 < argc) {
+            seed = static_cast<unsigned int>(std::stoul(argv[++i]));
+        } else if (arg == "--trace" && i + 1 < argc) {
+            traceFile = argv[++i];
+        } else if (mapFile.empty()) {
+            mapFile = arg;
+        } else if (queryFile.empty()) {
+            queryFile = arg;
+        } else {
+            mapFile.clear();
+            break;
+        }
+    }
+    if (mapFile.empty()) {
+        std::cerr << "用法：campus-query <地图文件(.txt|.ctg)> [查询文件] [--seed N] [--trace 输出文件]\n";
+        return 2;
+    }
+
+    if (!traceFile.empty()) {
+        Profiler::instance().setEnabled(true);
+    }
+
+    // 加载地图
+    auto loadStart = Clock::now();
+    std::string content;
+    if (!readFile(mapFile, content)) {
+        std::cerr << "无法打开文件：" << mapFile << "\n";
+        return 1;
+    }
+    Graph graph;
+    std::string error;
+    bool loaded = endsWith(mapFile, ".ctg") ? GraphSnapshot::load(content, graph, error)
+                                            : loadText(content, seed, graph, error);
+    if (!loaded) {
+        std::cerr << error << "\n";
+        return 1;
+    }
+    double loadMs = std::chrono::duration<double, std::milli>(Clock::now() - loadStart).count();
+    std::cout << "# 加载完成：" << graph.getCsrGraph()->size() << " 个节点，耗时 " << loadMs << " ms\n";
+
+    std::ifstream queryStream;
+    if (!queryFile.empty()) {
+        queryStream.open(queryFile);
+        if (!queryStream) {
+            std::cerr << "无法打开文件：" << queryFile << "\n";
+            return 1;
+        }
+    }
+    std::istream& queries = queryFile.empty() ? std::cin : queryStream;
+
+    // 逐行执行查询
+    QuerySession session(graph);
+    std::string line;
+    int count = 0;
+    double totalUs = 0.0;
+    while (std::getline(queries, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        std::ostringstream result;
+        auto start = Clock::now();
+        bool known = session.run(line, result);
+        double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        if (!known) {
+            std::cout << line << "\n  无法识别的查询\n";
+            continue;
+        }
+        ++count;
+        totalUs += us;
+        std::cout << line << "\n  " << result.str() << "\n  # 耗时 " << us << " us\n";
+    }
+
+    if (count > 0) {
+        std::printf("# 共 %d 条查询，总耗时 %.3f ms，平均 %.1f us，吞吐量 %.0f 次/秒\n",
+                    count, totalUs / 1000.0, totalUs / count, count / (totalUs / 1e6));
+    }
+
+    if (!traceFile.empty()) {
+        for (const auto& stats : Profiler::instance().statistics()) {
+            std::printf("# %-24s %8llu 次  p50 %.1f us  p95 %.1f us  p99 %.1f us  最大 %.1f us\n",
+                        stats.name.c_str(), static_cast<unsigned long long>(stats.count),
+                        stats.p50Us, stats.p95Us, stats.p99Us, stats.maxUs);
+        }
+        std::ofstream traceStream(traceFile, std::ios::binary);
+        traceStream << Profiler::instance().chromeTrace();
+        if (!traceStream) {
+            std::cerr << "无法写入文件：" << traceFile << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}